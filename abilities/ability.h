@@ -1,15 +1,50 @@
 #ifndef ABILITY_H
 #define ABILITY_H
 
-#include <string>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
 class GameField;
 class ShipManager;
 
+enum class AbilityType : std::uint8_t {
+    DoubleDamage,
+    Scanner,
+    Bombard
+};
+
+// What the caller wants from the ability at the head of the queue. The
+// target and area are only read by abilities that aim at the field; a
+// non-positive area leaves the ability's default window in place.
+struct AbilityRequest {
+    AbilityType type;
+    int x{-1};
+    int y{-1};
+    int width{0};
+    int height{0};
+};
+
+// A scan counts every ship cell in its area in shipCells and keeps the
+// first MAX_CELLS of them, enough for the default window, in cells; each
+// cell found is also reported as a ScanFound event.
+struct AbilityResult {
+    static const int MAX_CELLS = 4;
+
+    AbilityType type;
+    bool used{false};
+    long long shipCells{0};
+    int cellCount{0};
+    std::array<std::pair<int, int>, MAX_CELLS> cells{};
+    int shipIndex{-1};
+    int segmentIndex{-1};
+};
+
 class Ability {
     public:
     virtual ~Ability() = default;
-    virtual bool use() = 0;
-    virtual std::string getName() const = 0;
+    virtual AbilityResult use(const AbilityRequest& request) = 0;
+    virtual std::string_view getName() const = 0;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,52 +1,101 @@
 #include "abilityManager.h"
-#include <random>
-#include <iostream>
-#include <memory>
+#include <variant>
 
-AbilityManager::AbilityManager() {
+namespace {
+
+using AbilityVariant = std::variant<DoubleDamageAbility, ScannerAbility, BombardAbility>;
+
+constexpr std::array<std::string_view, 3> ABILITY_NAMES = {"Double Damage", "Scanner", "Bombard"};
+
+AbilityVariant makeAbility(AbilityType type, GameField& targetField, ShipManager& shipManager,
+                           GameRng& rng) {
+    switch (type) {
+        case AbilityType::DoubleDamage:
+            return AbilityVariant(std::in_place_type<DoubleDamageAbility>, targetField);
+        case AbilityType::Scanner:
+            return AbilityVariant(std::in_place_type<ScannerAbility>, targetField, shipManager);
+        case AbilityType::Bombard:
+            break;
+    }
+    return AbilityVariant(std::in_place_type<BombardAbility>, targetField, shipManager, rng);
+}
+
+}
+
+AbilityManager::AbilityManager() : AbilityManager(GameRng(GameRng::randomSeed())) {
+}
+
+AbilityManager::AbilityManager(GameRng rng) : rng(rng) {
     addRandomAbility();
 }
 
-void AbilityManager::addRandomAbility() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    int abilityType = std::uniform_int_distribution<>(0, 2)(gen);
-    switch(abilityType) {
-        case 0: abilities.push_back(std::make_unique<DoubleDamageAbility>()); break;
-        case 1: abilities.push_back(std::make_unique<ScannerAbility>()); break;
-        case 2: abilities.push_back(std::make_unique<BombardAbility>()); break;
-    }
+void AbilityManager::reset(GameRng value) {
+    clearAbilities();
+    rng = value;
+    addRandomAbility();
 }
 
-bool AbilityManager::useAbility(GameField& targetField, ShipManager& shipManager) {
-    if (abilities.empty())
-        throw NoAbilityException();
+std::string_view AbilityManager::abilityName(AbilityType type) {
+    return ABILITY_NAMES[static_cast<std::size_t>(type)];
+}
 
-    std::string abilityName = abilities.front()->getName();
-    abilities.pop_front();
+bool AbilityManager::parseAbilityName(std::string_view name, AbilityType& type) {
+    for (std::size_t i = 0; i < ABILITY_NAMES.size(); ++i) {
+        if (ABILITY_NAMES[i] == name) {
+            type = static_cast<AbilityType>(i);
+            return true;
+        }
+    }
+    return false;
+}
 
-    if (abilityName == "Double Damage") {
-        DoubleDamageAbility ability(targetField);
-        return ability.use();
+bool AbilityManager::abilityFromCode(unsigned code, AbilityType& type) {
+    if (code >= ABILITY_NAMES.size()) {
+        return false;
     }
-    else if (abilityName == "Scanner") {
-        ScannerAbility ability(targetField, shipManager);
-        return ability.use();
+    type = static_cast<AbilityType>(code);
+    return true;
+}
+
+bool AbilityManager::addAbility(AbilityType type) {
+    if (count == CAPACITY) {
+        return false;
     }
-    else if (abilityName == "Bombard") {
-        BombardAbility ability(targetField, shipManager);
-        return ability.use();
+    queue[(head + count) % CAPACITY] = type;
+    ++count;
+    return true;
+}
+
+bool AbilityManager::addRandomAbility() {
+    return addAbility(static_cast<AbilityType>(rng.below(ABILITY_NAMES.size())));
+}
+
+AbilityResult AbilityManager::useAbility(const AbilityRequest& request, GameField& targetField,
+                                        ShipManager& shipManager) {
+    AbilityType type = front();
+    if (type != request.type) {
+        return AbilityResult{request.type};
     }
-    return false;
+    discardFirstAbility();
+
+    AbilityVariant ability = makeAbility(type, targetField, shipManager, rng);
+    return std::visit([&request](auto& chosen) { return chosen.use(request); }, ability);
 }
 
-bool AbilityManager::hasAbilities() const {
-    return !abilities.empty();
+void AbilityManager::discardFirstAbility() {
+    if (count == 0)
+        throw NoAbilityException();
+    head = (head + 1) % CAPACITY;
+    --count;
 }
 
-std::string AbilityManager::getFirstAbilityName() const {
-    if (abilities.empty()) {
+AbilityType AbilityManager::front() const {
+    if (count == 0) {
         throw NoAbilityException();
     }
-    return abilities.front()->getName();
+    return queue[head];
+}
+
+std::string_view AbilityManager::getFirstAbilityName() const {
+    return abilityName(front());
 }
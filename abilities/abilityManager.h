@@ -1,38 +1,55 @@
 #ifndef ABILITY_MANAGER_H
 #define ABILITY_MANAGER_H
 
-#include <memory>
-#include <deque>   
+#include <array>
+#include <cstddef>
+#include <string_view>
 #include "ability.h"
 #include "doubleDamageAbility.h"
 #include "scannerAbility.h"
 #include "bombardAbility.h"
 #include "../exceptions/gameExceptions.h"
+#include "../mainElements/gamerng.h"
 
+// Pending abilities are one-byte tags in a fixed ring buffer, so granting
+// and using an ability never touches the heap; a grant that finds the
+// queue full is dropped. Using an ability builds the matching ability in
+// a std::variant on the stack and dispatches through std::visit.
 class AbilityManager {
-    private:
-    std::deque<std::unique_ptr<Ability>> abilities; 
-
     public:
-    const std::deque<std::unique_ptr<Ability>>& getAbilities() const { return abilities; }
+    static constexpr std::size_t CAPACITY = 64;
+
+    AbilityManager();
+    explicit AbilityManager(GameRng rng);
+    void reset(GameRng rng);
+
+    static std::string_view abilityName(AbilityType type);
+    static bool parseAbilityName(std::string_view name, AbilityType& type);
+    static bool abilityFromCode(unsigned code, AbilityType& type);
+
+    bool addAbility(AbilityType type);
+    bool addRandomAbility();
+    AbilityResult useAbility(const AbilityRequest& request, GameField& targetField,
+                             ShipManager& shipManager);
+    void discardFirstAbility();
     void clearAbilities() {
-        abilities.clear();
+        head = 0;
+        count = 0;
     }
 
-    void addAbility(const std::string& name) {
-        if (name == "Double Damage") {
-            abilities.push_back(std::make_unique<DoubleDamageAbility>());
-        } else if (name == "Scanner") {
-            abilities.push_back(std::make_unique<ScannerAbility>());
-        } else if (name == "Bombard") {
-            abilities.push_back(std::make_unique<BombardAbility>());
-        }
-    }
-    AbilityManager();
-    void addRandomAbility();
-    bool useAbility(GameField& targetField, ShipManager& shipManager);
-    bool hasAbilities() const;
-    std::string getFirstAbilityName() const;
+    bool hasAbilities() const { return count > 0; }
+    std::size_t size() const { return count; }
+    AbilityType at(std::size_t index) const { return queue[(head + index) % CAPACITY]; }
+    AbilityType front() const;
+    std::string_view getFirstAbilityName() const;
+    const GameRng& getRng() const { return rng; }
+    void setRng(const GameRng& value) { rng = value; }
+
+    private:
+    std::array<AbilityType, CAPACITY> queue{};
+    std::size_t head{0};
+    std::size_t count{0};
+    GameRng rng;
 };
 
-#endif
\ No newline at end of file
+#endif
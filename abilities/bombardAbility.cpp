@@ -1,36 +1,27 @@
 #include "bombardAbility.h"
-#include <random>
 
-BombardAbility::BombardAbility(GameField& field, ShipManager& manager) {
+BombardAbility::BombardAbility(GameField& field, ShipManager& manager, GameRng& rng) {
     targetField = &field;
     shipManager = &manager;
+    this->rng = &rng;
 }
 
-bool BombardAbility::use() {
-    if (!targetField || !shipManager) return false;
+AbilityResult BombardAbility::use(const AbilityRequest&) {
+    AbilityResult result{AbilityType::Bombard};
+    if (!targetField || !shipManager || !rng) return result;
     
-    const auto& ships = shipManager->getShips();
-    if (ships.empty()) return false;
-
-    std::vector<int> availableShips;
-    for (size_t i = 0; i < ships.size(); i++) {
-        if (!ships[i].isDestroyed()) {
-            availableShips.push_back(i);
-        }
-    }
-
-    if (availableShips.empty()) return false;
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    int randomIndex = std::uniform_int_distribution<>(0, availableShips.size()-1)(gen);
+    std::size_t availableShips = shipManager->getAliveCount();
+    if (availableShips == 0) return result;
+    std::size_t ship = shipManager->getAliveShip(rng->below(availableShips));
+    int liveSegments = shipManager->getSegmentsLeft(ship);
     
-    shipIndex = availableShips[randomIndex];
-    Ship& ship = shipManager->getShip(shipIndex);
-    segmentIndex = std::uniform_int_distribution<>(0, ship.getLength()-1)(gen);
-    shipManager->applyDamageToShip(ship, segmentIndex, 1);
-    return true;
+    result.shipIndex = static_cast<int>(ship);
+    result.segmentIndex = shipManager->getLiveSegment(ship, static_cast<int>(rng->below(liveSegments)));
+    result.used = targetField->damageSegment(result.shipIndex, result.segmentIndex, 1).outcome !=
+                  AttackOutcome::OutOfBounds;
+    return result;
 }
 
-std::string BombardAbility::getName() const {
+std::string_view BombardAbility::getName() const {
     return "Bombard";
 }
\ No newline at end of file
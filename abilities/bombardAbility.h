@@ -2,21 +2,21 @@
 #define BOMBARD_ABILITY_H
 
 #include "ability.h"
+#include "../mainElements/gamerng.h"
 #include "../mainElements/gamefield.h"
 #include "../mainElements/shipmanager.h"
 
 class BombardAbility : public Ability {
     public:
     BombardAbility() = default;
-    BombardAbility(GameField& field, ShipManager& manager);
-    bool use() override;
-    std::string getName() const override;
+    BombardAbility(GameField& field, ShipManager& manager, GameRng& rng);
+    AbilityResult use(const AbilityRequest& request) override;
+    std::string_view getName() const override;
 
     private:
         GameField* targetField{nullptr};
         ShipManager* shipManager{nullptr};
-        int shipIndex{-1};
-        int segmentIndex{-1};
+        GameRng* rng{nullptr};
 };
 
 #endif
\ No newline at end of file
@@ -1,11 +1,13 @@
 #include "doubleDamageAbility.h"
 
-bool DoubleDamageAbility::use() {
-    if (!targetField) return false;
+AbilityResult DoubleDamageAbility::use(const AbilityRequest&) {
+    AbilityResult result{AbilityType::DoubleDamage};
+    if (!targetField) return result;
     targetField->setNextAttackDoubleDamage(true);
-    return true;
+    result.used = true;
+    return result;
 }
 
-std::string DoubleDamageAbility::getName() const {
+std::string_view DoubleDamageAbility::getName() const {
     return "Double Damage";
 }
\ No newline at end of file
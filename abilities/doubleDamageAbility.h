@@ -9,8 +9,8 @@ class DoubleDamageAbility : public Ability {
 public:
     DoubleDamageAbility() = default;
     DoubleDamageAbility(GameField& field) : targetField(&field) {}
-    bool use() override;
-    std::string getName() const override;
+    AbilityResult use(const AbilityRequest& request) override;
+    std::string_view getName() const override;
 
 private:
     GameField* targetField{nullptr};
@@ -1,39 +1,34 @@
 #include "scannerAbility.h"
-#include <iostream>
 
 ScannerAbility::ScannerAbility(GameField& field, ShipManager& manager) {
     targetField = &field;
     shipManager = &manager;
 }
 
-bool ScannerAbility::use() {
-    std::cout << "Enter the X coordinate: ";
-    std::cin >> x;
-    std::cout << "Enter the Y coordinate: ";
-    std::cin >> y;
+AbilityResult ScannerAbility::use(const AbilityRequest& request) {
+    AbilityResult result{AbilityType::Scanner};
+    if (!targetField || !shipManager) return result;
+    result.used = true;
     
-    if (!targetField || !shipManager) return true;
-    
-    bool shipFound = false;
-    
-    for (int i = 0; i < 2; ++i) {
-        for (int j = 0; j < 2; ++j) {
-            if (x + i < targetField->getWidth() && y + j < targetField->getHeight()) {
-                if (targetField->getCellStatus(x + i, y + j) == CellStatus::Ship) {
-                    shipFound = true;
-                    std::cout << "Ship found at (" << x + i << "," << y + j << ")\n";
-                }
-            }
-        }
+    int width = request.width > 0 ? request.width : SCAN_SIZE;
+    int height = request.height > 0 ? request.height : SCAN_SIZE;
+    result.shipCells = targetField->countShipCells(request.x, request.y, width, height);
+    if (result.shipCells == 0) {
+        targetField->getEventSink().emit(GameEvent::scanEmpty(request.x, request.y));
+        return result;
     }
     
-    if (!shipFound) {
-        std::cout << "No ships found in the scanned area.\n";
-    }
+    EventSink& events = targetField->getEventSink();
+    targetField->forEachShipCell(request.x, request.y, width, height, [&](int x, int y) {
+        if (result.cellCount < AbilityResult::MAX_CELLS) {
+            result.cells[result.cellCount++] = {x, y};
+        }
+        events.emit(GameEvent::scanFound(x, y));
+    });
     
-    return true;
-} 
+    return result;
+}
 
-std::string ScannerAbility::getName() const {
+std::string_view ScannerAbility::getName() const {
     return "Scanner";
-}
\ No newline at end of file
+}
@@ -7,16 +7,18 @@
 
 class ScannerAbility : public Ability {
     public:
+    static const int SCAN_SIZE = 2;
+    static_assert(SCAN_SIZE * SCAN_SIZE <= AbilityResult::MAX_CELLS,
+                  "the default scan window must fit in an AbilityResult");
+
     ScannerAbility() = default;
     ScannerAbility(GameField& field, ShipManager& manager);
-    bool use() override;
-    std::string getName() const override;
+    AbilityResult use(const AbilityRequest& request) override;
+    std::string_view getName() const override;
 
     private:
         GameField* targetField{nullptr};
         ShipManager* shipManager{nullptr};
-        int x{-1};
-        int y{-1};
 };
 
 #endif
\ No newline at end of file
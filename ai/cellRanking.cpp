@@ -0,0 +1,50 @@
+#include "cellRanking.h"
+
+void CellRanking::assign(std::size_t cells) {
+    leaves = 1;
+    while (leaves < cells) {
+        leaves <<= 1;
+    }
+    nodes.assign(2 * leaves, {-1, 1});
+}
+
+CellRanking::Node CellRanking::combine(const Node& left, const Node& right) {
+    if (left.score != right.score) {
+        return left.score > right.score ? left : right;
+    }
+    return {left.score, left.count + right.count};
+}
+
+void CellRanking::rebuild() {
+    for (std::size_t node = leaves - 1; node > 0; --node) {
+        nodes[node] = combine(nodes[2 * node], nodes[2 * node + 1]);
+    }
+}
+
+void CellRanking::set(int cell, int score) {
+    std::size_t node = leaves + static_cast<std::size_t>(cell);
+    if (nodes[node].score == score) {
+        return;
+    }
+    nodes[node].score = score;
+    for (node >>= 1; node > 0; node >>= 1) {
+        nodes[node] = combine(nodes[2 * node], nodes[2 * node + 1]);
+    }
+}
+
+int CellRanking::bestCell(int rank) const {
+    int best = nodes[1].score;
+    std::size_t node = 1;
+    while (node < leaves) {
+        const Node& left = nodes[2 * node];
+        if (left.score == best) {
+            if (rank < left.count) {
+                node = 2 * node;
+                continue;
+            }
+            rank -= left.count;
+        }
+        node = 2 * node + 1;
+    }
+    return static_cast<int>(node - leaves);
+}
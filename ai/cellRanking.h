@@ -0,0 +1,36 @@
+#ifndef CELL_RANKING_H
+#define CELL_RANKING_H
+
+#include <cstddef>
+#include <vector>
+
+// Tournament tree over per-cell scores. Every node keeps the best score
+// below it and how many cells reach that score, so the best score is read
+// at the root, a score change costs one walk to the root, and the n-th
+// best cell in index order is found by one walk down. Cells that must not
+// be picked hold a negative score. Picks depend only on the scores, never
+// on the order in which they were set.
+class CellRanking {
+    public:
+    void assign(std::size_t cells);
+    void setLeaf(int cell, int score) { nodes[leaves + cell] = {score, 1}; }
+    void rebuild();
+    void set(int cell, int score);
+
+    int bestScore() const { return nodes[1].score; }
+    int bestCount() const { return nodes[1].score < 0 ? 0 : nodes[1].count; }
+    int bestCell(int rank) const;
+
+    private:
+        struct Node {
+            int score;
+            int count;
+        };
+
+        std::size_t leaves{0};
+        std::vector<Node> nodes;
+
+        static Node combine(const Node& left, const Node& right);
+};
+
+#endif
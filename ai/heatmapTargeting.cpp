@@ -0,0 +1,320 @@
+#include "heatmapTargeting.h"
+#include <algorithm>
+
+HeatmapTargeting::HeatmapTargeting(const GameField& field, const ShipManager& ships,
+                                   GameRng rng)
+    : targetField(&field),
+      enemyShips(&ships),
+      width(field.getWidth()),
+      height(field.getHeight()),
+      rng(rng) {
+    HeatmapTargeting::reset(rng);
+}
+
+void HeatmapTargeting::reset(GameRng value) {
+    rng = value;
+    cells.assign(static_cast<std::size_t>(width) * height, Knowledge::Open);
+    heat.assign(cells.size(), 0);
+    scores.assign(cells.size(), 0);
+    damagedCells.clear();
+    wreckedCells.clear();
+    scoredCells.clear();
+    std::fill(remaining.begin(), remaining.end(), 0);
+    for (std::size_t i = 0; i < enemyShips->getShipCount(); ++i) {
+        int length = enemyShips->getLength(i);
+        if (length >= static_cast<int>(remaining.size())) {
+            remaining.resize(length + 1, 0);
+            coverage.resize(length + 1);
+        }
+        ++remaining[length];
+    }
+
+    for (int length = 1; length < static_cast<int>(coverage.size()); ++length) {
+        if (remaining[length] == 0) {
+            coverage[length].clear();
+            continue;
+        }
+        coverage[length].assign(cells.size(), 0);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (x + length <= width) {
+                    adjustCoverage(x, y, length, true, 1);
+                }
+                if (length > 1 && y + length <= height) {
+                    adjustCoverage(x, y, length, false, 1);
+                }
+            }
+        }
+    }
+
+    rankAll();
+
+    const BitBoard& board = targetField->getBoard();
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (board.test(BoardPlane::Shot, x, y)) {
+                recordShot(x, y);
+            }
+        }
+    }
+}
+
+bool HeatmapTargeting::placementFits(int x, int y, int length, bool horizontal, int skipCell) const {
+    if (x < 0 || y < 0 || (horizontal ? x + length > width : y + length > height)) {
+        return false;
+    }
+    for (int i = 0; i < length; ++i) {
+        int cell = horizontal ? index(x + i, y) : index(x, y + i);
+        if (cell != skipCell && isBlocked(cell)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HeatmapTargeting::adjustCoverage(int x, int y, int length, bool horizontal, int delta) {
+    std::vector<int>& counts = coverage[length];
+    for (int i = 0; i < length; ++i) {
+        int cell = horizontal ? index(x + i, y) : index(x, y + i);
+        counts[cell] += delta;
+        heat[cell] += delta;
+    }
+}
+
+void HeatmapTargeting::rankAround(int x, int y) {
+    int reach = std::max(static_cast<int>(coverage.size()) - 2, 0);
+    for (int xi = std::max(x - reach, 0); xi <= std::min(x + reach, width - 1); ++xi) {
+        rank(index(xi, y));
+    }
+    for (int yi = std::max(y - reach, 0); yi <= std::min(y + reach, height - 1); ++yi) {
+        if (yi != y) {
+            rank(index(x, yi));
+        }
+    }
+}
+
+void HeatmapTargeting::rankAll() {
+    ranking.assign(cells.size());
+    for (int cell = 0; cell < static_cast<int>(cells.size()); ++cell) {
+        ranking.setLeaf(cell, cells[cell] == Knowledge::Open ? heat[cell] : -1);
+    }
+    ranking.rebuild();
+}
+
+void HeatmapTargeting::block(int x, int y, Knowledge knowledge) {
+    int cell = index(x, y);
+    Knowledge previous = cells[cell];
+    if (isBlocked(cell)) {
+        cells[cell] = knowledge;
+        rank(cell);
+        onKnowledgeChanged(cell, previous);
+        return;
+    }
+    for (int length = 1; length < static_cast<int>(coverage.size()); ++length) {
+        if (coverage[length].empty()) {
+            continue;
+        }
+        for (int i = 0; i < length; ++i) {
+            if (placementFits(x - i, y, length, true, cell)) {
+                adjustCoverage(x - i, y, length, true, -1);
+            }
+            if (length > 1 && placementFits(x, y - i, length, false, cell)) {
+                adjustCoverage(x, y - i, length, false, -1);
+            }
+        }
+    }
+    cells[cell] = knowledge;
+    rankAround(x, y);
+    onKnowledgeChanged(cell, previous);
+}
+
+void HeatmapTargeting::markEmpty(int x, int y) {
+    if (x >= 0 && x < width && y >= 0 && y < height && cells[index(x, y)] == Knowledge::Open) {
+        block(x, y, Knowledge::Empty);
+    }
+}
+
+void HeatmapTargeting::markSunk(const Ship& ship, int x, int y, int segmentIndex) {
+    bool horizontal = ship.getOrientation() == Orientation::Horizontal;
+    int startX = horizontal ? x - segmentIndex : x;
+    int startY = horizontal ? y : y - segmentIndex;
+    int length = ship.getLength();
+    if (cells[index(startX, startY)] == Knowledge::Sunk) {
+        return;
+    }
+
+    for (int i = 0; i < length; ++i) {
+        block(horizontal ? startX + i : startX, horizontal ? startY : startY + i, Knowledge::Sunk);
+    }
+    int endX = horizontal ? startX + length - 1 : startX;
+    int endY = horizontal ? startY : startY + length - 1;
+    for (int yi = startY - 1; yi <= endY + 1; ++yi) {
+        for (int xi = startX - 1; xi <= endX + 1; ++xi) {
+            markEmpty(xi, yi);
+        }
+    }
+    if (length < static_cast<int>(remaining.size()) && remaining[length] > 0 &&
+        --remaining[length] == 0) {
+        const std::vector<int>& counts = coverage[length];
+        for (std::size_t cell = 0; cell < heat.size(); ++cell) {
+            heat[cell] -= counts[cell];
+        }
+        coverage[length].clear();
+        rankAll();
+    }
+}
+
+void HeatmapTargeting::recordShot(int x, int y) {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return;
+    }
+    CellInfo info = targetField->getCell(x, y);
+    const ShipManager* fleet = targetField->getShipManager();
+    if (info.status != CellStatus::Ship || info.shipIndex < 0 || fleet == nullptr ||
+        static_cast<std::size_t>(info.shipIndex) >= fleet->getShipCount()) {
+        markEmpty(x, y);
+        return;
+    }
+
+    Ship ship = fleet->getShip(static_cast<std::size_t>(info.shipIndex));
+    if (ship.isDestroyed()) {
+        markSunk(ship, x, y, info.segmentIndex);
+        return;
+    }
+
+    int cell = index(x, y);
+    SegmentState state = ship.getSegmentState(info.segmentIndex);
+    Knowledge previous = cells[cell];
+    if (state == SegmentState::Damaged && previous == Knowledge::Open) {
+        cells[cell] = Knowledge::Damaged;
+        damagedCells.push_back(cell);
+        rank(cell);
+        onKnowledgeChanged(cell, previous);
+    } else if (state == SegmentState::Destroyed && previous != Knowledge::Wrecked) {
+        cells[cell] = Knowledge::Wrecked;
+        wreckedCells.push_back(cell);
+        rank(cell);
+        onKnowledgeChanged(cell, previous);
+    }
+    if (state != SegmentState::Intact) {
+        markEmpty(x - 1, y - 1);
+        markEmpty(x + 1, y - 1);
+        markEmpty(x - 1, y + 1);
+        markEmpty(x + 1, y + 1);
+    }
+}
+
+bool HeatmapTargeting::chooseNearWreck(int& x, int& y) {
+    for (std::size_t i = 0; i < wreckedCells.size();) {
+        if (cells[wreckedCells[i]] != Knowledge::Wrecked) {
+            wreckedCells[i] = wreckedCells.back();
+            wreckedCells.pop_back();
+        } else {
+            ++i;
+        }
+    }
+
+    for (int wreck : wreckedCells) {
+        int wx = wreck % width;
+        int wy = wreck / width;
+        for (int length = 2; length < static_cast<int>(remaining.size()); ++length) {
+            if (remaining[length] == 0) {
+                continue;
+            }
+            for (int horizontal = 0; horizontal < 2; ++horizontal) {
+                for (int i = 0; i < length; ++i) {
+                    int sx = horizontal ? wx - i : wx;
+                    int sy = horizontal ? wy : wy - i;
+                    if (!placementFits(sx, sy, length, horizontal, -1)) {
+                        continue;
+                    }
+                    long long wrecks = 0;
+                    for (int k = 0; k < length; ++k) {
+                        int cell = horizontal ? index(sx + k, sy) : index(sx, sy + k);
+                        wrecks += cells[cell] == Knowledge::Wrecked;
+                    }
+                    long long weight = remaining[length] * wrecks * wrecks;
+                    for (int k = 0; k < length; ++k) {
+                        int cell = horizontal ? index(sx + k, sy) : index(sx, sy + k);
+                        if (cells[cell] == Knowledge::Open) {
+                            if (scores[cell] == 0) {
+                                scoredCells.push_back(cell);
+                            }
+                            scores[cell] += weight;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(scoredCells.begin(), scoredCells.end());
+    long long best = 0;
+    int ties = 0;
+    int chosen = -1;
+    for (int cell : scoredCells) {
+        if (scores[cell] > best) {
+            best = scores[cell];
+            ties = 1;
+            chosen = cell;
+        } else if (scores[cell] == best &&
+                   rng.below(++ties) == 0) {
+            chosen = cell;
+        }
+        scores[cell] = 0;
+    }
+    scoredCells.clear();
+    if (chosen < 0) {
+        return false;
+    }
+    x = chosen % width;
+    y = chosen / width;
+    return true;
+}
+
+bool HeatmapTargeting::chooseHottest(int& x, int& y) {
+    int ties = ranking.bestCount();
+    if (ties == 0) {
+        return false;
+    }
+    int chosen = ranking.bestCell(static_cast<int>(rng.below(static_cast<std::uint64_t>(ties))));
+    x = chosen % width;
+    y = chosen / width;
+    return true;
+}
+
+bool HeatmapTargeting::chooseDamaged(int& x, int& y) {
+    int cell = -1;
+    for (std::size_t i = 0; i < damagedCells.size();) {
+        if (cells[damagedCells[i]] != Knowledge::Damaged) {
+            damagedCells[i] = damagedCells.back();
+            damagedCells.pop_back();
+            continue;
+        }
+        if (cell < 0 || damagedCells[i] < cell) {
+            cell = damagedCells[i];
+        }
+        ++i;
+    }
+    if (cell < 0) {
+        return false;
+    }
+    x = cell % width;
+    y = cell / width;
+    return true;
+}
+
+bool HeatmapTargeting::chooseTarget(int& x, int& y) {
+    return chooseDamaged(x, y) || chooseNearWreck(x, y) || chooseHottest(x, y);
+}
+
+long long HeatmapTargeting::getHeat(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return 0;
+    }
+    return heat[index(x, y)];
+}
+
+std::string HeatmapTargeting::getName() const {
+    return "Hunt/Target";
+}
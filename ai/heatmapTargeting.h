@@ -0,0 +1,82 @@
+#ifndef HEATMAP_TARGETING_H
+#define HEATMAP_TARGETING_H
+
+#include <cstdint>
+#include <vector>
+#include "targetingStrategy.h"
+#include "cellRanking.h"
+#include "../mainElements/gamefield.h"
+#include "../mainElements/shipmanager.h"
+#include "../mainElements/gamerng.h"
+
+// Hunt/target strategy. For every ship length still afloat it keeps, per
+// cell, how many placements consistent with the shots so far cover that
+// cell, and a cell's heat is the sum over those lengths. A cell that turns
+// out empty or sunk only invalidates the placements through it, so a shot
+// changes the heat of the cells within one ship length of it, and a
+// tournament tree over the heat of the open cells yields the hottest cell
+// without a scan. Only sinking the last ship of a length touches every
+// cell, once, to drop that length's counts. Damaged segments are finished
+// off first, then open cells in line with destroyed segments of a
+// floating ship, then the hottest cell. Every choice depends only on what
+// is known about the cells and on the generator, never on the order the
+// shots came in, so reset() on a board rebuilds a strategy that makes the
+// same moves as the one that played it.
+class HeatmapTargeting : public TargetingStrategy {
+    public:
+    HeatmapTargeting(const GameField& field, const ShipManager& ships,
+                     GameRng rng);
+    bool chooseTarget(int& x, int& y) override;
+    void recordShot(int x, int y) override;
+    void reset(GameRng rng) override;
+    const GameRng& getRng() const override { return rng; }
+    std::string getName() const override;
+
+    long long getHeat(int x, int y) const;
+
+    protected:
+        enum class Knowledge : std::uint8_t {
+            Open,
+            Empty,
+            Damaged,
+            Wrecked,
+            Sunk
+        };
+
+        const GameField* targetField;
+        const ShipManager* enemyShips;
+        int width;
+        int height;
+        GameRng rng;
+        std::vector<Knowledge> cells;
+        std::vector<int> remaining;
+        std::vector<int> damagedCells;
+
+        int index(int x, int y) const { return y * width + x; }
+        bool isBlocked(int cell) const {
+            return cells[cell] == Knowledge::Empty || cells[cell] == Knowledge::Sunk;
+        }
+        bool chooseDamaged(int& x, int& y);
+        virtual void onKnowledgeChanged(int, Knowledge) {}
+
+    private:
+        std::vector<std::vector<int>> coverage;
+        std::vector<int> heat;
+        CellRanking ranking;
+        std::vector<int> wreckedCells;
+        std::vector<long long> scores;
+        std::vector<int> scoredCells;
+
+        bool placementFits(int x, int y, int length, bool horizontal, int skipCell) const;
+        void adjustCoverage(int x, int y, int length, bool horizontal, int delta);
+        void rank(int cell) { ranking.set(cell, cells[cell] == Knowledge::Open ? heat[cell] : -1); }
+        void rankAround(int x, int y);
+        void rankAll();
+        void block(int x, int y, Knowledge knowledge);
+        void markEmpty(int x, int y);
+        void markSunk(const Ship& ship, int x, int y, int segmentIndex);
+        bool chooseNearWreck(int& x, int& y);
+        bool chooseHottest(int& x, int& y);
+};
+
+#endif
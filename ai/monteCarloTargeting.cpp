@@ -0,0 +1,203 @@
+#include "monteCarloTargeting.h"
+#include <algorithm>
+
+MonteCarloTargeting::MonteCarloTargeting(const GameField& field, const ShipManager& ships,
+                                         const std::vector<int>& shipSizes,
+                                         GameRng rng,
+                                         std::chrono::milliseconds moveBudget,
+                                         unsigned threads,
+                                         long long sampleLimit)
+    : HeatmapTargeting(field, ships, rng),
+      moveBudget(moveBudget) {
+    for (int size : shipSizes) {
+        if (size >= static_cast<int>(fleetCounts.size())) {
+            fleetCounts.resize(size + 1, 0);
+        }
+        ++fleetCounts[size];
+    }
+
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    workers.resize(threads == 0 ? 1 : threads);
+    samplesPerWorker = std::max(1LL, sampleLimit / static_cast<long long>(workers.size()));
+    for (auto& worker : workers) {
+        worker.placer = std::make_unique<FleetPlacer>(width, height);
+    }
+    seedWorkers();
+    for (std::size_t slot = 0; slot + 1 < workers.size(); ++slot) {
+        helpers.emplace_back(&MonteCarloTargeting::helperLoop, this, slot);
+    }
+}
+
+MonteCarloTargeting::~MonteCarloTargeting() {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    poolWake.notify_all();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+}
+
+void MonteCarloTargeting::reset(GameRng value) {
+    HeatmapTargeting::reset(value);
+    seedWorkers();
+}
+
+void MonteCarloTargeting::helperLoop(std::size_t slot) {
+    std::uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(poolMutex);
+    while (true) {
+        poolWake.wait(lock, [this, &seen] { return stopping || moveGeneration != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = moveGeneration;
+        lock.unlock();
+        sample(workers[slot]);
+        lock.lock();
+        if (--pendingHelpers == 0) {
+            poolDone.notify_one();
+        }
+    }
+}
+
+void MonteCarloTargeting::seedWorkers() {
+    initialRemaining.assign(fleetCounts.size(), 0);
+    for (std::size_t i = 0; i < enemyShips->getShipCount(); ++i) {
+        if (enemyShips->getLength(i) < static_cast<int>(initialRemaining.size())) {
+            ++initialRemaining[enemyShips->getLength(i)];
+        }
+    }
+    for (auto& worker : workers) {
+        worker.gen = rng.split();
+    }
+    collectKnownCells();
+}
+
+void MonteCarloTargeting::collectKnownCells() {
+    blockedCells.clear();
+    requiredCells.clear();
+    appliedBlocked = 0;
+    for (auto& worker : workers) {
+        worker.placer->clearBlockedCells();
+    }
+    for (int cell = 0; cell < static_cast<int>(cells.size()); ++cell) {
+        if (isBlocked(cell)) {
+            blockedCells.push_back(cell);
+        } else if (cells[cell] != Knowledge::Open) {
+            requiredCells.push_back(cell);
+        }
+    }
+}
+
+void MonteCarloTargeting::onKnowledgeChanged(int cell, Knowledge previous) {
+    if (isBlocked(cell)) {
+        if (previous != Knowledge::Empty && previous != Knowledge::Sunk) {
+            blockedCells.push_back(cell);
+        }
+    } else if (previous == Knowledge::Open && cells[cell] != Knowledge::Open) {
+        requiredCells.push_back(cell);
+    }
+}
+
+void MonteCarloTargeting::sample(Worker& worker) {
+    const std::vector<int>& lengths = moveLengths;
+    worker.counts.assign(cells.size(), 0);
+    worker.samples = 0;
+    while (worker.samples < samplesPerWorker && std::chrono::steady_clock::now() < moveDeadline) {
+        if (!worker.placer->placeFleet(lengths, worker.gen, worker.placements, moveDeadline)) {
+            continue;
+        }
+        for (std::size_t i = 0; i < worker.placements.size(); ++i) {
+            const ShipPlacement& placement = worker.placements[i];
+            bool horizontal = placement.orientation == Orientation::Horizontal;
+            for (int k = 0; k < lengths[i]; ++k) {
+                ++worker.counts[horizontal ? index(placement.x + k, placement.y)
+                                           : index(placement.x, placement.y + k)];
+            }
+        }
+        ++worker.samples;
+    }
+}
+
+bool MonteCarloTargeting::chooseTarget(int& x, int& y) {
+    if (chooseDamaged(x, y)) {
+        return true;
+    }
+
+    moveLengths.clear();
+    for (int length = static_cast<int>(fleetCounts.size()) - 1; length >= 1; --length) {
+        int sunk = length < static_cast<int>(remaining.size())
+            ? initialRemaining[length] - remaining[length] : 0;
+        for (int i = sunk; i < fleetCounts[length]; ++i) {
+            moveLengths.push_back(length);
+        }
+    }
+    requiredCells.erase(std::remove_if(requiredCells.begin(), requiredCells.end(),
+                                       [this](int cell) { return isBlocked(cell); }),
+                        requiredCells.end());
+    for (auto& worker : workers) {
+        for (std::size_t i = appliedBlocked; i < blockedCells.size(); ++i) {
+            worker.placer->blockCell(blockedCells[i]);
+        }
+        worker.placer->clearRequiredCells();
+        for (int cell : requiredCells) {
+            worker.placer->requireCell(cell);
+        }
+    }
+    appliedBlocked = blockedCells.size();
+
+    moveDeadline = std::chrono::steady_clock::now() + moveBudget;
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        pendingHelpers = helpers.size();
+        ++moveGeneration;
+    }
+    poolWake.notify_all();
+    sample(workers.back());
+    {
+        std::unique_lock<std::mutex> lock(poolMutex);
+        poolDone.wait(lock, [this] { return pendingHelpers == 0; });
+    }
+
+    lastSampleCount = 0;
+    for (const auto& worker : workers) {
+        lastSampleCount += worker.samples;
+    }
+    if (lastSampleCount == 0) {
+        return HeatmapTargeting::chooseTarget(x, y);
+    }
+
+    long long best = -1;
+    int ties = 0;
+    int chosen = -1;
+    for (int cell = 0; cell < static_cast<int>(cells.size()); ++cell) {
+        if (cells[cell] != Knowledge::Open) {
+            continue;
+        }
+        long long hits = 0;
+        for (const auto& worker : workers) {
+            hits += worker.counts[cell];
+        }
+        if (hits > best) {
+            best = hits;
+            ties = 1;
+            chosen = cell;
+        } else if (hits == best && rng.below(++ties) == 0) {
+            chosen = cell;
+        }
+    }
+    if (chosen < 0) {
+        return HeatmapTargeting::chooseTarget(x, y);
+    }
+    x = chosen % width;
+    y = chosen / width;
+    return true;
+}
+
+std::string MonteCarloTargeting::getName() const {
+    return "Monte Carlo";
+}
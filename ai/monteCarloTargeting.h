@@ -0,0 +1,82 @@
+#ifndef MONTE_CARLO_TARGETING_H
+#define MONTE_CARLO_TARGETING_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "heatmapTargeting.h"
+#include "../mainElements/fleetplacer.h"
+
+// Samples whole fleet layouts that agree with every shot so far (no ship on
+// a known empty or sunk cell, every hit segment of a floating ship covered)
+// on several threads until the per-move deadline or the sample limit, then
+// shoots the open cell occupied most often. Each sample first anchors a
+// ship on every hit of a floating ship, drawn among the placements that
+// cover it, and then draws the rest of the fleet around them, so samples
+// with open hits are built directly instead of being filtered out of
+// unconstrained ones. Falls back to hunt/target when no sample fits in
+// time. The sampling threads live as long as the strategy and wait for the
+// next move between moves; the blocked and hit cells are collected as
+// shots land, so a move only hands the samplers the cells blocked since
+// the previous one.
+class MonteCarloTargeting : public HeatmapTargeting {
+    public:
+    MonteCarloTargeting(const GameField& field, const ShipManager& ships,
+                        const std::vector<int>& shipSizes,
+                        GameRng rng,
+                        std::chrono::milliseconds moveBudget,
+                        unsigned threads = 0,
+                        long long sampleLimit = 20000);
+    ~MonteCarloTargeting() override;
+    MonteCarloTargeting(const MonteCarloTargeting&) = delete;
+    MonteCarloTargeting& operator=(const MonteCarloTargeting&) = delete;
+
+    bool chooseTarget(int& x, int& y) override;
+    void reset(GameRng rng) override;
+    bool isRepeatable() const override { return false; }
+    std::string getName() const override;
+
+    long long getLastSampleCount() const { return lastSampleCount; }
+
+    private:
+        struct Worker {
+            std::unique_ptr<FleetPlacer> placer;
+            GameRng gen;
+            std::vector<int> counts;
+            std::vector<ShipPlacement> placements;
+            long long samples{0};
+        };
+
+        std::vector<int> fleetCounts;
+        std::vector<int> initialRemaining;
+        std::chrono::milliseconds moveBudget;
+        long long samplesPerWorker;
+        std::vector<Worker> workers;
+        long long lastSampleCount{0};
+
+        std::vector<int> blockedCells;
+        std::vector<int> requiredCells;
+        std::size_t appliedBlocked{0};
+        std::vector<int> moveLengths;
+        FleetPlacer::Deadline moveDeadline;
+
+        std::vector<std::thread> helpers;
+        std::mutex poolMutex;
+        std::condition_variable poolWake;
+        std::condition_variable poolDone;
+        std::uint64_t moveGeneration{0};
+        std::size_t pendingHelpers{0};
+        bool stopping{false};
+
+        void seedWorkers();
+        void collectKnownCells();
+        void onKnowledgeChanged(int cell, Knowledge previous) override;
+        void helperLoop(std::size_t slot);
+        void sample(Worker& worker);
+};
+
+#endif
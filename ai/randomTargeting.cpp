@@ -0,0 +1,88 @@
+#include "randomTargeting.h"
+
+namespace {
+
+const long long DENSE_CELLS = 1LL << 22;
+const int SPARSE_PROBES = 256;
+
+}
+
+RandomTargeting::RandomTargeting(const GameField& field, GameRng rng)
+    : targetField(&field), rng(rng), dense(false) {
+    RandomTargeting::reset(rng);
+}
+
+void RandomTargeting::reset(GameRng value) {
+    rng = value;
+    int width = targetField->getWidth();
+    int height = targetField->getHeight();
+    dense = width > 0 && height > 0 && static_cast<long long>(width) * height <= DENSE_CELLS;
+    if (!dense) {
+        return;
+    }
+    openCells.assign(static_cast<std::size_t>(width) * height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            openCells.setLeaf(y * width + x, isFinished(x, y) ? -1 : 0);
+        }
+    }
+    openCells.rebuild();
+}
+
+bool RandomTargeting::isFinished(int x, int y) const {
+    const BitBoard& board = targetField->getBoard();
+    return board.test(BoardPlane::Miss, x, y) || board.test(BoardPlane::Destroyed, x, y);
+}
+
+bool RandomTargeting::chooseTarget(int& x, int& y) {
+    if (!dense) {
+        return chooseSparse(x, y);
+    }
+    int open = openCells.bestCount();
+    if (open == 0) {
+        return false;
+    }
+    int cell = openCells.bestCell(static_cast<int>(rng.below(static_cast<std::uint64_t>(open))));
+    x = cell % targetField->getWidth();
+    y = cell / targetField->getWidth();
+    return true;
+}
+
+bool RandomTargeting::chooseSparse(int& x, int& y) {
+    int width = targetField->getWidth();
+    int height = targetField->getHeight();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    for (int attempt = 0; attempt < SPARSE_PROBES; ++attempt) {
+        x = rng.between(0, width - 1);
+        y = rng.between(0, height - 1);
+        if (!isFinished(x, y)) {
+            return true;
+        }
+    }
+    long long total = static_cast<long long>(width) * height;
+    long long start = rng.between(0LL, total - 1);
+    for (long long i = 0; i < total; ++i) {
+        long long cell = (start + i) % total;
+        x = static_cast<int>(cell % width);
+        y = static_cast<int>(cell / width);
+        if (!isFinished(x, y)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RandomTargeting::recordShot(int x, int y) {
+    if (!dense || !targetField->getBoard().inBounds(x, y)) {
+        return;
+    }
+    if (isFinished(x, y)) {
+        openCells.set(y * targetField->getWidth() + x, -1);
+    }
+}
+
+std::string RandomTargeting::getName() const {
+    return "Random";
+}
@@ -0,0 +1,35 @@
+#ifndef RANDOM_TARGETING_H
+#define RANDOM_TARGETING_H
+
+#include <vector>
+#include "targetingStrategy.h"
+#include "cellRanking.h"
+#include "../mainElements/gamefield.h"
+#include "../mainElements/gamerng.h"
+
+// Uniform choice among the cells that can still change: untargeted cells
+// and damaged segments that need another hit. A tournament tree over the
+// cells counts the open ones, so picking the n-th open cell and retiring a
+// cell are both O(log cells), and the pick depends only on which cells are
+// finished, never on the order they were shot in. Boards too large for the
+// tree draw random cells and skip finished ones.
+class RandomTargeting : public TargetingStrategy {
+    public:
+    RandomTargeting(const GameField& field, GameRng rng);
+    bool chooseTarget(int& x, int& y) override;
+    void recordShot(int x, int y) override;
+    void reset(GameRng rng) override;
+    const GameRng& getRng() const override { return rng; }
+    std::string getName() const override;
+
+    private:
+        const GameField* targetField;
+        GameRng rng;
+        bool dense;
+        CellRanking openCells;
+
+        bool isFinished(int x, int y) const;
+        bool chooseSparse(int& x, int& y);
+};
+
+#endif
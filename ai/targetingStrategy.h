@@ -0,0 +1,20 @@
+#ifndef TARGETING_STRATEGY_H
+#define TARGETING_STRATEGY_H
+
+#include <string>
+#include "../mainElements/gamerng.h"
+
+class TargetingStrategy {
+    public:
+    virtual ~TargetingStrategy() = default;
+    virtual bool chooseTarget(int& x, int& y) = 0;
+    virtual void recordShot(int x, int y) = 0;
+    virtual void reset(GameRng rng) = 0;
+    virtual const GameRng& getRng() const = 0;
+    // False when the choice depends on timing, so replaying the shots
+    // cannot repeat it.
+    virtual bool isRepeatable() const { return true; }
+    virtual std::string getName() const = 0;
+};
+
+#endif
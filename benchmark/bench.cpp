@@ -0,0 +1,329 @@
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "benchrunner.h"
+#include "../abilities/bombardAbility.h"
+#include "../mainElements/fleetplacer.h"
+#include "../mainElements/game.h"
+#include "../mainElements/gamestate.h"
+#include "../simulation/selfplay.h"
+
+namespace fs = std::filesystem;
+
+struct BenchOptions {
+    int warmup{2};
+    int repetitions{15};
+    std::string output;
+    std::string baseline;
+    double thresholdPct{10.0};
+    std::string filter;
+    std::uint64_t seed{42};
+};
+
+struct BenchScenario {
+    int width;
+    int height;
+    int fleets;
+    int queries;
+    int moveLimit;
+    std::vector<TargetingMode> fullGames;
+};
+
+const std::vector<BenchScenario> SCENARIOS = {
+    {10, 10, 1, 10000, 100, {TargetingMode::Random, TargetingMode::HuntTarget}},
+    {100, 100, 10, 10000, 500, {TargetingMode::Random}},
+    {1000, 1000, 100, 10000, 10, {}}
+};
+
+std::string strategyLabel(TargetingMode mode) {
+    switch (mode) {
+        case TargetingMode::Random: return "random";
+        case TargetingMode::HuntTarget: return "hunt";
+        case TargetingMode::MonteCarlo: return "montecarlo";
+    }
+    return "";
+}
+
+// Keeps the compiler from discarding results of the timed loops.
+volatile long long benchSink = 0;
+
+struct PlacedFleet {
+    std::unique_ptr<GameField> field;
+    std::unique_ptr<ShipManager> ships;
+};
+
+void displayUsage() {
+    std::cout << "Usage: benchmarks [options]\n"
+              << "  --warmup N      - Untimed runs before each case (default 2)\n"
+              << "  --reps N        - Timed samples per case (default 15)\n"
+              << "  --out FILE      - Write the JSON report to FILE instead of stdout\n"
+              << "  --baseline FILE - Compare median times against an earlier report\n"
+              << "  --threshold PCT - Slowdown that counts as a regression (default 10)\n"
+              << "  --filter TEXT   - Only run cases whose id contains TEXT\n"
+              << "  --seed N        - Seed for fleets, queries and strategies (default 42)\n";
+}
+
+BenchOptions parseOptions(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+        std::string value = argv[++i];
+        if (arg == "--warmup") {
+            options.warmup = std::stoi(value);
+        } else if (arg == "--reps") {
+            options.repetitions = std::stoi(value);
+        } else if (arg == "--out") {
+            options.output = value;
+        } else if (arg == "--baseline") {
+            options.baseline = value;
+        } else if (arg == "--threshold") {
+            options.thresholdPct = std::stod(value);
+        } else if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--seed") {
+            options.seed = std::stoull(value);
+        } else {
+            throw std::invalid_argument("Unknown option " + arg);
+        }
+    }
+    return options;
+}
+
+std::vector<int> fleetOf(int fleets) {
+    std::vector<int> fleet;
+    for (int i = 0; i < fleets; ++i) {
+        fleet.insert(fleet.end(), Game::defaultShipSizes().begin(), Game::defaultShipSizes().end());
+    }
+    return fleet;
+}
+
+PlacedFleet placeFleet(int width, int height, const std::vector<int>& fleet, std::uint64_t seed) {
+    PlacedFleet placed{std::make_unique<GameField>(width, height), std::make_unique<ShipManager>(fleet)};
+    placed.field->setEventSink(nullEventSink());
+    GameRng gen(seed);
+    FleetPlacer placer(width, height);
+    if (!placer.placeFleet(*placed.field, *placed.ships, gen)) {
+        throw std::runtime_error("Fleet does not fit on the benchmark board");
+    }
+    placed.field->refreshScanTables();
+    return placed;
+}
+
+void addScenarioCases(std::vector<BenchCase>& cases, const BenchScenario& scenario,
+                      std::uint64_t seed, const fs::path& savePath) {
+    int width = scenario.width;
+    int height = scenario.height;
+    std::string board = std::to_string(width) + "x" + std::to_string(height);
+    std::vector<int> fleet = fleetOf(scenario.fleets);
+    int ships = static_cast<int>(fleet.size());
+    GameRng gen(seed);
+
+    struct Query {
+        int length;
+        int x;
+        int y;
+        Orientation orientation;
+    };
+    auto queries = std::make_shared<std::vector<Query>>();
+    for (int i = 0; i < scenario.queries; ++i) {
+        queries->push_back({gen.between(1, Ship::MAX_LENGTH), gen.between(0, width - 1),
+                            gen.between(0, height - 1),
+                            gen.coin() ? Orientation::Horizontal : Orientation::Vertical});
+    }
+    auto placedForQueries = std::make_shared<PlacedFleet>(placeFleet(width, height, fleet, seed));
+    cases.push_back({"canPlaceShip", board, ships, [] {}, [queries, placedForQueries] {
+        long long fits = 0;
+        for (const Query& query : *queries) {
+            Ship ship(query.length, query.orientation);
+            fits += placedForQueries->field->canPlaceShip(ship, query.x, query.y, query.orientation);
+        }
+        benchSink = fits;
+        return static_cast<long long>(queries->size());
+    }});
+
+    auto fresh = std::make_shared<PlacedFleet>();
+    auto placer = std::make_shared<FleetPlacer>(width, height);
+    auto placerGen = std::make_shared<GameRng>(gen.split());
+    cases.push_back({"placeFleet", board, ships, [fresh, width, height, fleet] {
+        fresh->field = std::make_unique<GameField>(width, height);
+        fresh->field->setEventSink(nullEventSink());
+        fresh->ships = std::make_unique<ShipManager>(fleet);
+    }, [fresh, placer, placerGen] {
+        benchSink = placer->placeFleet(*fresh->field, *fresh->ships, *placerGen);
+        return 1LL;
+    }});
+
+    auto targets = std::make_shared<std::vector<int>>();
+    long long cells = static_cast<long long>(width) * height;
+    for (int i = 0; i < scenario.queries; ++i) {
+        targets->push_back(static_cast<int>(gen.below(static_cast<std::uint64_t>(cells))));
+    }
+    auto target = std::make_shared<PlacedFleet>();
+    cases.push_back({"attackCell", board, ships, [target, width, height, fleet, seed] {
+        *target = placeFleet(width, height, fleet, seed);
+    }, [target, targets, width] {
+        long long hits = 0;
+        for (int cell : *targets) {
+            AttackResult result = target->field->attackCell(cell % width, cell / width);
+            hits += result.outcome == AttackOutcome::Hit || result.outcome == AttackOutcome::Sunk;
+        }
+        benchSink = hits;
+        return static_cast<long long>(targets->size());
+    }});
+
+    auto bombarded = std::make_shared<PlacedFleet>();
+    auto bombardGen = std::make_shared<GameRng>(gen.split());
+    auto grants = std::make_shared<AbilityManager>();
+    int bombards = scenario.queries;
+    cases.push_back({"bombard", board, ships, [bombarded, grants, width, height, fleet, seed] {
+        *bombarded = placeFleet(width, height, fleet, seed);
+        grants->reset(GameRng(seed));
+        bombarded->field->setAbilityManager(grants.get());
+    }, [bombarded, bombardGen, bombards] {
+        BombardAbility bombard(*bombarded->field, *bombarded->ships, *bombardGen);
+        long long uses = 0;
+        while (uses < bombards && bombard.use(AbilityRequest{AbilityType::Bombard}).used) {
+            ++uses;
+        }
+        benchSink = uses;
+        return uses;
+    }});
+
+    TargetingSettings settings;
+    settings.shipSizes = fleet;
+    for (TargetingMode mode : {TargetingMode::Random, TargetingMode::HuntTarget}) {
+        std::string name = "makeMove/" + strategyLabel(mode);
+        auto shooter = std::make_shared<std::unique_ptr<ComputerPlayer>>();
+        auto defender = std::make_shared<PlacedFleet>();
+        auto shooterGen = std::make_shared<GameRng>(gen.split());
+        int moveLimit = scenario.moveLimit;
+        cases.push_back({name, board, ships, [=] {
+            shooter->reset();
+            *defender = placeFleet(width, height, fleet, seed);
+            *shooter = std::make_unique<ComputerPlayer>(defender->field.get(), defender->ships.get(),
+                                                        mode, settings, shooterGen->split());
+        }, [=] {
+            long long moves = 0;
+            while (moves < moveLimit && !defender->ships->allShipsDestroyed()) {
+                (*shooter)->makeMove();
+                ++moves;
+            }
+            return moves;
+        }});
+    }
+
+    auto game = std::make_shared<Game>(width, height, fleet, seed);
+    game->setEventSink(nullEventSink());
+    PlacedFleet playerSide = placeFleet(width, height, fleet, seed);
+    PlacedFleet computerSide = placeFleet(width, height, fleet, seed + 1);
+    game->updateGameComponents(std::move(playerSide.field), std::move(computerSide.field),
+                               std::move(playerSide.ships), std::move(computerSide.ships),
+                               std::make_unique<AbilityManager>(gen.split()));
+    game->setGameStatus(GameStatus::InProgress);
+    std::string path = savePath.string();
+    cases.push_back({"saveLoad", board, ships, [] {}, [game, path] {
+        GameState::saveGame(*game, path);
+        GameState::loadGame(*game, path);
+        return 1LL;
+    }});
+
+    auto rounds = std::make_shared<Game>(width, height, fleet, seed);
+    rounds->setEventSink(nullEventSink());
+    rounds->setAutoPlacement(true);
+    rounds->setComputerTargeting(TargetingMode::HuntTarget);
+    rounds->startNewGame();
+    BenchCase newRound{"newRound", board, ships, [] {}, [rounds] {
+        rounds->startNewGame();
+        for (int round = 0; round < 2; ++round) {
+            rounds->setGameStatus(GameStatus::PlayerWon);
+            rounds->startNextRound();
+        }
+        return 3LL;
+    }};
+    newRound.allocationFree = true;
+    cases.push_back(newRound);
+
+    settings.threads = 1;
+    for (TargetingMode mode : scenario.fullGames) {
+        auto match = std::make_shared<SelfPlayMatch>(width, height, fleet, mode, settings);
+        auto matchGen = std::make_shared<GameRng>(gen.split());
+        cases.push_back({"fullGame/" + strategyLabel(mode), board, ships, [] {}, [match, matchGen] {
+            benchSink = match->play(*matchGen).moves;
+            return 1LL;
+        }});
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        displayUsage();
+        return 1;
+    }
+
+    fs::path savePath = fs::temp_directory_path() / ("battleship-bench-" + std::to_string(options.seed) + ".sav");
+    std::vector<BenchStats> results;
+    int regressions = 0;
+    int allocating = 0;
+    try {
+        BenchRunner runner(options.warmup, options.repetitions);
+        std::vector<BenchCase> cases;
+        for (const auto& scenario : SCENARIOS) {
+            addScenarioCases(cases, scenario, options.seed, savePath);
+        }
+        for (const auto& benchCase : cases) {
+            std::string id = benchCase.name + "/" + benchCase.board;
+            if (id.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            std::cerr << std::left << std::setw(32) << id << std::flush;
+            results.push_back(runner.run(benchCase));
+            std::cerr << std::right << std::fixed << std::setprecision(1)
+                      << "p50 " << std::setw(14) << results.back().p50Ns << " ns"
+                      << "  p99 " << std::setw(14) << results.back().p99Ns << " ns"
+                      << "  allocs " << std::setw(10) << results.back().allocationsPerOp << "\n";
+            if (results.back().allocated) {
+                std::cerr << "Allocation: " << id << " allocated "
+                          << results.back().allocationsPerOp << " times per operation\n";
+                ++allocating;
+            }
+        }
+        if (!options.baseline.empty()) {
+            regressions = compareWithBaseline(results, readBaseline(options.baseline), options.thresholdPct);
+            for (const auto& stats : results) {
+                if (stats.regressed) {
+                    std::cerr << "Regression: " << stats.id << " median " << std::setprecision(1)
+                              << stats.changePct << "% slower than baseline\n";
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        fs::remove(savePath);
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    fs::remove(savePath);
+
+    if (options.output.empty()) {
+        writeReport(std::cout, results, options.seed, options.baseline, options.thresholdPct, regressions);
+    } else {
+        std::ofstream file(options.output);
+        if (!file) {
+            std::cerr << "Error: cannot write " << options.output << "\n";
+            return 1;
+        }
+        writeReport(file, results, options.seed, options.baseline, options.thresholdPct, regressions);
+    }
+    return regressions > 0 || allocating > 0 ? 2 : 0;
+}
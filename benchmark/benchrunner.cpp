@@ -0,0 +1,235 @@
+#include "benchrunner.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+
+std::atomic<std::uint64_t> allocationCount{0};
+
+void* countedAllocation(std::size_t size, std::size_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    void* memory = alignment > alignof(std::max_align_t)
+        ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+        : std::malloc(size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+std::string quoted(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+bool readStringField(const std::string& text, std::size_t& pos, const std::string& key, std::string& value) {
+    std::size_t found = text.find("\"" + key + "\"", pos);
+    if (found == std::string::npos) {
+        return false;
+    }
+    std::size_t open = text.find('"', text.find(':', found) + 1);
+    std::size_t close = text.find('"', open + 1);
+    if (open == std::string::npos || close == std::string::npos) {
+        return false;
+    }
+    value = text.substr(open + 1, close - open - 1);
+    pos = close + 1;
+    return true;
+}
+
+bool readNumberField(const std::string& text, std::size_t& pos, const std::string& key, double& value) {
+    std::size_t found = text.find("\"" + key + "\"", pos);
+    if (found == std::string::npos) {
+        return false;
+    }
+    std::size_t colon = text.find(':', found);
+    std::size_t end = 0;
+    value = std::stod(text.substr(colon + 1), &end);
+    pos = colon + 1 + end;
+    return true;
+}
+
+}
+
+void* operator new(std::size_t size) {
+    return countedAllocation(size, 0);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocation(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+BenchRunner::BenchRunner(int warmup, int repetitions)
+    : warmup(warmup), repetitions(repetitions) {
+    if (warmup < 0 || repetitions <= 0) {
+        throw std::invalid_argument("Benchmark needs at least one repetition");
+    }
+}
+
+BenchStats BenchRunner::run(const BenchCase& benchCase) const {
+    for (int i = 0; i < warmup; ++i) {
+        benchCase.setup();
+        benchCase.run();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(repetitions);
+    long long totalOps = 0;
+    std::uint64_t allocations = 0;
+    for (int i = 0; i < repetitions; ++i) {
+        benchCase.setup();
+        std::uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        long long ops = benchCase.run();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        ops = std::max(ops, 1LL);
+        totalOps += ops;
+        samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / ops);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchStats stats;
+    stats.name = benchCase.name;
+    stats.board = benchCase.board;
+    stats.id = benchCase.name + "/" + benchCase.board;
+    stats.ships = benchCase.ships;
+    stats.samples = repetitions;
+    stats.opsPerSample = totalOps / repetitions;
+    stats.minNs = samples.front();
+    stats.maxNs = samples.back();
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    stats.meanNs = sum / samples.size();
+    stats.p50Ns = percentile(samples, 0.50);
+    stats.p90Ns = percentile(samples, 0.90);
+    stats.p99Ns = percentile(samples, 0.99);
+    stats.allocationsPerOp = static_cast<double>(allocations) / totalOps;
+    stats.allocated = benchCase.allocationFree && allocations > 0;
+    return stats;
+}
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(std::max(rank, std::size_t{1}), sorted.size()) - 1];
+}
+
+std::map<std::string, double> readBaseline(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open baseline " + filename);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::map<std::string, double> baseline;
+    std::size_t pos = text.find("\"results\"");
+    std::string id;
+    double p50 = 0;
+    while (pos != std::string::npos && readStringField(text, pos, "id", id)) {
+        if (!readNumberField(text, pos, "p50_ns", p50)) {
+            break;
+        }
+        baseline[id] = p50;
+    }
+    if (baseline.empty()) {
+        throw std::runtime_error("Baseline " + filename + " has no results");
+    }
+    return baseline;
+}
+
+int compareWithBaseline(std::vector<BenchStats>& results,
+                        const std::map<std::string, double>& baseline, double thresholdPct) {
+    int regressions = 0;
+    for (auto& stats : results) {
+        auto it = baseline.find(stats.id);
+        if (it == baseline.end() || it->second <= 0) {
+            continue;
+        }
+        stats.hasBaseline = true;
+        stats.baselineP50Ns = it->second;
+        stats.changePct = (stats.p50Ns - it->second) / it->second * 100.0;
+        stats.regressed = stats.changePct > thresholdPct;
+        if (stats.regressed) {
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+void writeReport(std::ostream& os, const std::vector<BenchStats>& results, std::uint64_t seed,
+                 const std::string& baselineFile, double thresholdPct, int regressions) {
+    os << std::fixed << std::setprecision(1)
+       << "{\n"
+       << "  \"seed\": " << seed << ",\n";
+    if (!baselineFile.empty()) {
+        os << "  \"baseline\": " << quoted(baselineFile) << ",\n"
+           << "  \"threshold_pct\": " << thresholdPct << ",\n"
+           << "  \"regressions\": " << regressions << ",\n";
+    }
+    os << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchStats& stats = results[i];
+        os << "    {\"id\": " << quoted(stats.id)
+           << ", \"name\": " << quoted(stats.name)
+           << ", \"board\": " << quoted(stats.board)
+           << ", \"ships\": " << stats.ships
+           << ", \"samples\": " << stats.samples
+           << ", \"ops_per_sample\": " << stats.opsPerSample
+           << ", \"min_ns\": " << stats.minNs
+           << ", \"mean_ns\": " << stats.meanNs
+           << ", \"p50_ns\": " << stats.p50Ns
+           << ", \"p90_ns\": " << stats.p90Ns
+           << ", \"p99_ns\": " << stats.p99Ns
+           << ", \"max_ns\": " << stats.maxNs
+           << ", \"allocs_per_op\": " << stats.allocationsPerOp;
+        if (stats.hasBaseline) {
+            os << ", \"baseline_p50_ns\": " << stats.baselineP50Ns
+               << ", \"change_pct\": " << stats.changePct
+               << ", \"regressed\": " << (stats.regressed ? "true" : "false");
+        }
+        os << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n"
+       << "}\n";
+}
@@ -0,0 +1,64 @@
+#ifndef BENCH_RUNNER_H
+#define BENCH_RUNNER_H
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+struct BenchCase {
+    std::string name;
+    std::string board;
+    int ships;
+    std::function<void()> setup;
+    std::function<long long()> run;
+    bool allocationFree{false};
+};
+
+struct BenchStats {
+    std::string id;
+    std::string name;
+    std::string board;
+    int ships{0};
+    int samples{0};
+    long long opsPerSample{0};
+    double minNs{0};
+    double meanNs{0};
+    double p50Ns{0};
+    double p90Ns{0};
+    double p99Ns{0};
+    double maxNs{0};
+    double allocationsPerOp{0};
+    bool allocated{false};
+    bool hasBaseline{false};
+    double baselineP50Ns{0};
+    double changePct{0};
+    bool regressed{false};
+};
+
+// Times each case as warmup runs followed by measured samples. setup() runs
+// before every sample outside the timed region, run() returns how many
+// operations it performed, and the statistics are nanoseconds per operation.
+// The benchmark binary counts every operator new, so each case also reports
+// heap allocations per operation; a case marked allocationFree that
+// allocates inside the timed region is flagged.
+class BenchRunner {
+public:
+    BenchRunner(int warmup, int repetitions);
+    BenchStats run(const BenchCase& benchCase) const;
+
+private:
+    int warmup;
+    int repetitions;
+};
+
+double percentile(const std::vector<double>& sorted, double fraction);
+std::map<std::string, double> readBaseline(const std::string& filename);
+int compareWithBaseline(std::vector<BenchStats>& results,
+                        const std::map<std::string, double>& baseline, double thresholdPct);
+void writeReport(std::ostream& os, const std::vector<BenchStats>& results, std::uint64_t seed,
+                 const std::string& baselineFile, double thresholdPct, int regressions);
+
+#endif
@@ -5,22 +5,33 @@
 #include <limits>
 #include <filesystem>
 #include <vector>
+#include <memory>
 #include <iomanip>
+#include <unistd.h>
 #include "mainElements/game.h"
 #include "mainElements/gamestate.h"
+#include "mainElements/gamejournal.h"
+#include "mainElements/metrics.h"
+#include "mainElements/terminalrenderer.h"
 
 namespace fs = std::filesystem;
 
+const std::string AUTOSAVE_SNAPSHOT = "autosave.snapshot";
+const std::string AUTOSAVE_JOURNAL = "autosave.journal";
+
 std::string getSaveFilePath(const std::string& filename) {
+    return filename + ".sav";
+}
+
+std::string getExportFilePath(const std::string& filename) {
     return filename + ".txt";
 }
 
 std::vector<std::string> listSaveFiles() {
     std::vector<std::string> saves;
     for (const auto& entry : fs::directory_iterator(".")) {
-        if (entry.path().extension() == ".txt") {
-            std::string filename = entry.path().stem().string();
-            saves.push_back(filename);
+        if (entry.path().extension() == ".sav" || entry.path().extension() == ".txt") {
+            saves.push_back(entry.path().filename().string());
         }
     }
     return saves;
@@ -82,14 +93,6 @@ std::string selectSaveFile(bool isLoading) {
     }
 }
 
-void clearScreen() {
-    #ifdef _WIN32
-        system("cls");
-    #else
-        system("clear");
-    #endif
-}
-
 void displayHelp() {
     std::cout << "\nAvailable commands:\n"
               << "  attack x y   - Attack position (x,y)\n"
@@ -97,28 +100,47 @@ void displayHelp() {
               << "  save         - Save current game\n"
               << "  load         - Load saved game\n"
               << "  saves        - List saved games\n"
+              << "  export       - Export game as readable text\n"
               << "  display      - Show game fields\n"
+              << "  view x y     - Show the fields starting at (x,y)\n"
+              << "  stats        - Show counters and latencies (stats json, stats prometheus)\n"
+              << "  stats dump file seconds - Rewrite file with metrics periodically\n"
+              << "                 (.prom for Prometheus text, JSON otherwise; stats dump off)\n"
               << "  help         - Show this help\n"
               << "  quit         - Exit game\n";
 }
 
-int main() {
-    Game game;
+int playGame(Game& game, bool& restart) {
     std::string input;
     const int MAX_ROUNDS = 3;
 
     std::cout << "Welcome to Battleship!\n";
-    std::cout << "Enter 'new' to start a new game or 'load' to load a saved game: ";
+    std::cout << "Game seed: " << game.getSeed() << "\n";
+    bool canRecover = fs::exists(AUTOSAVE_SNAPSHOT);
+    if (canRecover) {
+        std::cout << "Enter 'new' to start a new game, 'load' to load a saved game "
+                  << "or 'recover' to resume the last session: ";
+    } else {
+        std::cout << "Enter 'new' to start a new game or 'load' to load a saved game: ";
+    }
     std::getline(std::cin, input);
 
     try {
-        if (input == "load") {
+        if (input == "recover" && canRecover) {
+            try {
+                GameJournal::recover(game, AUTOSAVE_SNAPSHOT, AUTOSAVE_JOURNAL);
+                std::cout << "Last session recovered.\n";
+            } catch (const std::exception& e) {
+                std::cout << "Failed to recover game: " << e.what() << "\nStarting a new game instead.\n";
+                game.startNewGame();
+            }
+        } else if (input == "load") {
             try {
                 std::string filename = selectSaveFile(true);
                 if (filename.empty()) {
                     game.startNewGame();
                 } else {
-                    GameState::loadGame(game, getSaveFilePath(filename));
+                    GameState::loadGame(game, filename);
                     std::cout << "Game loaded successfully.\n";
                 }
             } catch (const std::exception& e) {
@@ -128,8 +150,11 @@ int main() {
         } else {
             game.startNewGame();
         }
+        game.enableJournal(AUTOSAVE_SNAPSHOT, AUTOSAVE_JOURNAL);
 
         displayHelp();
+        TerminalRenderer renderer(std::cout);
+        std::unique_ptr<MetricsDumper> metricsDumper;
 
         while (true) {
             while (!game.isGameOver()) {
@@ -171,12 +196,56 @@ int main() {
                     return 0;
                 } 
                 else if (input == "display") {
-                    clearScreen();
+                    renderer.render(game, true);
+                }
+                else if (input.rfind("view", 0) == 0) {
+                    std::istringstream iss(input);
+                    std::string command;
+                    int x, y;
+                    iss >> command >> x >> y;
+
+                    if (iss.fail()) {
+                        std::cout << "Invalid view format. Use: view x y\n";
+                        continue;
+                    }
+                    game.setViewport(x, y);
+                    if (renderer.isLive()) {
+                        renderer.render(game, false);
+                        continue;
+                    }
                     std::cout << "Your Field:\n";
                     game.displayField(game, true);
                     std::cout << "\nEnemy Field:\n";
                     game.displayField(game, false);
-                    game.displayLegend();
+                }
+                else if (input.rfind("stats", 0) == 0) {
+                    std::istringstream iss(input);
+                    std::string command, mode, path;
+                    long long seconds = 0;
+                    iss >> command >> mode;
+                    if (mode.empty()) {
+                        metrics().writeText(std::cout);
+                    } else if (mode == "json") {
+                        metrics().writeJson(std::cout);
+                    } else if (mode == "prometheus") {
+                        metrics().writePrometheus(std::cout);
+                    } else if (mode == "dump" && (iss >> path) && path == "off") {
+                        metricsDumper.reset();
+                        std::cout << "Metrics dump stopped.\n";
+                    } else if (mode == "dump" && (iss >> seconds) && seconds > 0) {
+                        MetricsFormat format = path.size() > 5 && path.compare(path.size() - 5, 5, ".prom") == 0
+                            ? MetricsFormat::Prometheus : MetricsFormat::Json;
+                        try {
+                            metricsDumper.reset();
+                            metricsDumper = std::make_unique<MetricsDumper>(path, std::chrono::seconds(seconds), format);
+                            std::cout << "Writing metrics to " << path << " every " << seconds << " s.\n";
+                        } catch (const std::exception& e) {
+                            std::cout << "Failed to start metrics dump: " << e.what() << "\n";
+                        }
+                    } else {
+                        std::cout << "Invalid stats format. Use: stats [json|prometheus], "
+                                  << "stats dump file seconds or stats dump off\n";
+                    }
                 }
                 else if (input == "saves") {
                     displaySaves();
@@ -192,23 +261,54 @@ int main() {
                         std::cout << "Failed to save game: " << e.what() << "\n";
                     }
                 } 
+                else if (input == "export") {
+                    try {
+                        std::string filename = selectSaveFile(false);
+                        if (!filename.empty()) {
+                            GameState::exportText(game, getExportFilePath(filename));
+                            std::cout << "Game exported successfully.\n";
+                        }
+                    } catch (const std::exception& e) {
+                        std::cout << "Failed to export game: " << e.what() << "\n";
+                    }
+                }
                 else if (input == "load") {
                     try {
                         std::string filename = selectSaveFile(true);
                         if (!filename.empty()) {
-                            GameState::loadGame(game, getSaveFilePath(filename));
+                            GameState::loadGame(game, filename);
                             std::cout << "Game loaded successfully.\n";
                         }
                     } catch (const std::exception& e) {
                         std::cout << "Failed to load game: " << e.what() << "\n";
                     }
+                    if (renderer.isLive()) {
+                        renderer.render(game, true);
+                    }
                 } 
                 else if (input == "ability") {
                     if (!game.hasPlayerAbility()) {
                         std::cout << "No ability available.\n";
                         continue;
                     }
-                    game.usePlayerAbility();
+                    AbilityRequest request{game.getPlayerAbilities()->front()};
+                    if (request.type == AbilityType::Scanner) {
+                        std::cout << "Enter the X coordinate: ";
+                        std::cin >> request.x;
+                        std::cout << "Enter the Y coordinate: ";
+                        std::cin >> request.y;
+                        if (!std::cin) {
+                            std::cin.clear();
+                            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                            std::cout << "Invalid coordinates.\n";
+                            continue;
+                        }
+                        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    }
+                    game.usePlayerAbility(request);
+                    if (renderer.isLive()) {
+                        renderer.render(game, false);
+                    }
                 } 
                 else if (input.rfind("attack", 0) == 0) {
                     std::istringstream iss(input);
@@ -229,6 +329,9 @@ int main() {
                     } else {
                         std::cout << "Invalid attack coordinates or cell already targeted.\n";
                     }
+                    if (renderer.isLive()) {
+                        renderer.render(game, false);
+                    }
                 } 
                 else {
                     std::cout << "Unknown command. Type 'help' for available commands.\n";
@@ -238,6 +341,7 @@ int main() {
             if (game.getGameStatus() == GameStatus::PlayerWon) {
                 if (game.getCurrentRound() < MAX_ROUNDS) {
                     std::cout << "\nCongratulations! You won round " << game.getCurrentRound() << "!\n";
+                    renderer.release();
                     game.startNextRound();
                     continue;
                 } else {
@@ -250,10 +354,11 @@ int main() {
             }
         }
 
+        renderer.release();
         std::cout << "Would you like to start a new game? (yes/no): ";
         std::getline(std::cin, input);
         if (input == "yes" || input == "y") {
-            main();
+            restart = true;
         }
 
     } catch (const std::exception& e) {
@@ -261,6 +366,50 @@ int main() {
         return 1;
     }
 
-    std::cout << "Thanks for playing!\n";
+    if (!restart) {
+        std::cout << "Thanks for playing!\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    int width = 10;
+    int height = 10;
+    std::uint64_t seed = GameRng::randomSeed();
+    if (argc == 3 || argc == 4) {
+        try {
+            width = std::stoi(argv[1]);
+            height = std::stoi(argv[2]);
+            if (argc == 4) {
+                seed = std::stoull(argv[3]);
+            }
+        } catch (const std::exception&) {
+            width = 0;
+        }
+        if (width < 1 || width > 100000 || height < 1 || height > 100000) {
+            std::cerr << "Usage: game [width height [seed]], with sizes from 1 to 100000\n";
+            return 1;
+        }
+    }
+
+    // Without a terminal on stdout the game runs headless, so events are
+    // formatted on a background thread; Game flushes the sink after every
+    // action, which keeps them in order with the prompts.
+    std::unique_ptr<AsyncEventSink> asyncEvents;
+    Game game(width, height, Game::defaultShipSizes(), seed);
+    if (!isatty(STDOUT_FILENO)) {
+        asyncEvents = std::make_unique<AsyncEventSink>(std::cout);
+        game.setEventSink(*asyncEvents);
+    }
+    bool restart = true;
+    for (std::uint64_t played = 0; restart; ++played) {
+        restart = false;
+        if (played > 0) {
+            game.reseed(GameRng::stream(seed, played)());
+        }
+        if (playGame(game, restart) != 0) {
+            return 1;
+        }
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,327 @@
+#include "bitboard.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace {
+
+constexpr int MAX_SHAPE_LENGTH = 64;
+
+constexpr std::array<std::uint64_t, MAX_SHAPE_LENGTH + 1> makeShapeMasks() {
+    std::array<std::uint64_t, MAX_SHAPE_LENGTH + 1> masks{};
+    for (int length = 1; length < MAX_SHAPE_LENGTH; ++length) {
+        masks[length] = (std::uint64_t{1} << length) - 1;
+    }
+    masks[MAX_SHAPE_LENGTH] = ~std::uint64_t{0};
+    return masks;
+}
+
+constexpr std::array<std::uint64_t, MAX_SHAPE_LENGTH + 1> shapeMasks = makeShapeMasks();
+
+bool spanIntersects(std::uint64_t first, std::uint64_t second, int offset, int length) {
+    std::uint64_t mask = shapeMasks[length];
+    if (first & (mask << offset)) {
+        return true;
+    }
+    return offset + length > 64 && (second & (mask >> (64 - offset)));
+}
+
+// Bits of the first word where a run of length free cells starts, the run
+// continuing into the second word past bit 63.
+std::uint64_t spanStarts(std::uint64_t first, std::uint64_t second, int length) {
+    std::uint64_t starts = first;
+    for (int shift = 1; shift < length && starts != 0; ++shift) {
+        starts &= (first >> shift) | (second << (64 - shift));
+    }
+    return starts;
+}
+
+}
+
+BitBoard::BitBoard(int width, int height)
+    : width(width > 0 ? width : 0),
+      height(height > 0 ? height : 0),
+      chunksX((static_cast<std::uint64_t>(this->width) + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      chunksY((static_cast<std::uint64_t>(this->height) + CHUNK_SIZE - 1) / CHUNK_SIZE) {
+    if (chunksX * chunksY <= DIRECTORY_LIMIT) {
+        directory.assign(chunksX * chunksY, -1);
+    }
+}
+
+void BitBoard::clear() {
+    chunks.clear();
+    tags.clear();
+    for (auto& entry : chunkMap) {
+        entry.second = -1;
+    }
+    std::fill(directory.begin(), directory.end(), -1);
+}
+
+BitBoard::Chunk& BitBoard::chunkAt(int cx, int cy) {
+    std::uint64_t key = chunkKey(cx, cy);
+    int& slot = directory.empty() ? chunkMap.try_emplace(key, -1).first->second : directory[key];
+    if (slot < 0) {
+        slot = static_cast<int>(chunks.size());
+        chunks.emplace_back();
+        tags.emplace_back();
+        Chunk& chunk = chunks.back();
+        chunk.key = key;
+    }
+    return chunks[slot];
+}
+
+void BitBoard::setTag(int x, int y, std::uint16_t value) {
+    int slot = findSlot(x >> 6, y >> 6);
+    if (slot < 0) {
+        if (value == 0) {
+            return;
+        }
+        chunkAt(x >> 6, y >> 6);
+        slot = findSlot(x >> 6, y >> 6);
+    }
+    tags[slot][tagIndex(x, y)] = value;
+}
+
+std::uint64_t BitBoard::rowWord(BoardPlane plane, int cx, int y) const {
+    const Chunk* chunk = findChunk(cx, y >> 6);
+    return chunk == nullptr ? 0 : chunk->rows[rowIndex(plane, y)];
+}
+
+std::uint64_t BitBoard::columnWord(int x, int cy) const {
+    const Chunk* chunk = findChunk(x >> 6, cy);
+    return chunk == nullptr ? 0 : chunk->forbiddenColumns[x & 63];
+}
+
+bool BitBoard::canFitShip(int x, int y, int length, Orientation orientation) const {
+    if (length < 1 || length > MAX_SHAPE_LENGTH || x < 0 || y < 0) {
+        return false;
+    }
+    if (orientation == Orientation::Horizontal) {
+        if (x >= width - length + 1 || y >= height) {
+            return false;
+        }
+        int offset = x & 63;
+        std::uint64_t first = rowWord(BoardPlane::Forbidden, x >> 6, y);
+        std::uint64_t second = offset + length > 64 ? rowWord(BoardPlane::Forbidden, (x >> 6) + 1, y) : 0;
+        return !spanIntersects(first, second, offset, length);
+    }
+    if (y >= height - length + 1 || x >= width) {
+        return false;
+    }
+    int offset = y & 63;
+    std::uint64_t first = columnWord(x, y >> 6);
+    std::uint64_t second = offset + length > 64 ? columnWord(x, (y >> 6) + 1) : 0;
+    return !spanIntersects(first, second, offset, length);
+}
+
+void BitBoard::markShip(int x, int y, int length, Orientation orientation) {
+    bool horizontal = orientation == Orientation::Horizontal;
+    for (int i = 0; i < length; ++i) {
+        set(BoardPlane::Ship, horizontal ? x + i : x, horizontal ? y : y + i);
+    }
+    int x1 = horizontal ? x + length - 1 : x;
+    int y1 = horizontal ? y : y + length - 1;
+    forbidRect(x - 1, y - 1, x1 + 1, y1 + 1);
+}
+
+void BitBoard::markShipCell(int x, int y) {
+    set(BoardPlane::Ship, x, y);
+    forbidRect(x - 1, y - 1, x + 1, y + 1);
+}
+
+void BitBoard::unmarkShip(int x, int y, int length, Orientation orientation) {
+    bool horizontal = orientation == Orientation::Horizontal;
+    for (int i = 0; i < length; ++i) {
+        reset(BoardPlane::Ship, horizontal ? x + i : x, horizontal ? y : y + i);
+    }
+    int x1 = horizontal ? x + length - 1 : x;
+    int y1 = horizontal ? y : y + length - 1;
+    refreshForbidden(x - 1, y - 1, x1 + 1, y1 + 1);
+}
+
+void BitBoard::blockCell(int x, int y) {
+    set(BoardPlane::Blocked, x, y);
+    forbidRect(x, y, x, y);
+}
+
+void BitBoard::rebuildForbidden() {
+    for (Chunk& chunk : chunks) {
+        std::fill_n(chunk.rows.begin() + rowIndex(BoardPlane::Forbidden, 0), CHUNK_SIZE, 0);
+        chunk.forbiddenColumns.fill(0);
+    }
+    std::vector<std::pair<int, int>> sources;
+    forEachCell(BoardPlane::Ship, [&sources](int x, int y) { sources.emplace_back(x, y); });
+    for (const auto& cell : sources) {
+        forbidRect(cell.first - 1, cell.second - 1, cell.first + 1, cell.second + 1);
+    }
+    sources.clear();
+    forEachCell(BoardPlane::Blocked, [&sources](int x, int y) { sources.emplace_back(x, y); });
+    for (const auto& cell : sources) {
+        forbidRect(cell.first, cell.second, cell.first, cell.second);
+    }
+}
+
+std::uint64_t BitBoard::columnMask(int cx) const {
+    return shapeMasks[std::min(CHUNK_SIZE, width - cx * CHUNK_SIZE)];
+}
+
+std::uint64_t BitBoard::rowMask(int cy) const {
+    return shapeMasks[std::min(CHUNK_SIZE, height - cy * CHUNK_SIZE)];
+}
+
+std::uint64_t BitBoard::dilatedShipRow(int cx, int y) const {
+    std::uint64_t left = 0;
+    std::uint64_t middle = 0;
+    std::uint64_t right = 0;
+    for (int row = std::max(y - 1, 0); row <= std::min(y + 1, height - 1); ++row) {
+        middle |= rowWord(BoardPlane::Ship, cx, row);
+        if (cx > 0) {
+            left |= rowWord(BoardPlane::Ship, cx - 1, row);
+        }
+        if (static_cast<std::uint64_t>(cx) + 1 < chunksX) {
+            right |= rowWord(BoardPlane::Ship, cx + 1, row);
+        }
+    }
+    return middle | (middle << 1) | (middle >> 1) | (left >> 63) | (right << 63);
+}
+
+void BitBoard::refreshForbidden(int x0, int y0, int x1, int y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width - 1);
+    y1 = std::min(y1, height - 1);
+    for (int cx = x0 >> 6; cx <= x1 >> 6; ++cx) {
+        int left = std::max(x0 - cx * CHUNK_SIZE, 0);
+        int right = std::min(x1 - cx * CHUNK_SIZE, CHUNK_SIZE - 1);
+        std::uint64_t span = shapeMasks[right - left + 1] << left;
+        for (int y = y0; y <= y1; ++y) {
+            std::uint64_t forbidden = (dilatedShipRow(cx, y) | rowWord(BoardPlane::Blocked, cx, y)) & span;
+            Chunk* chunk = forbidden != 0 ? &chunkAt(cx, y >> 6) : findChunk(cx, y >> 6);
+            if (chunk == nullptr) {
+                continue;
+            }
+            std::uint64_t& row = chunk->rows[rowIndex(BoardPlane::Forbidden, y)];
+            row = (row & ~span) | forbidden;
+            std::uint64_t columnBit = std::uint64_t{1} << (y & 63);
+            for (int bit = left; bit <= right; ++bit) {
+                std::uint64_t& column = chunk->forbiddenColumns[bit];
+                column = ((forbidden >> bit) & 1u) ? (column | columnBit) : (column & ~columnBit);
+            }
+        }
+    }
+}
+
+void BitBoard::forbidRect(int x0, int y0, int x1, int y1) {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width - 1);
+    y1 = std::min(y1, height - 1);
+    for (int cy = y0 >> 6; cy <= y1 >> 6; ++cy) {
+        int top = std::max(y0 - cy * CHUNK_SIZE, 0);
+        int bottom = std::min(y1 - cy * CHUNK_SIZE, CHUNK_SIZE - 1);
+        std::uint64_t columnSpan = shapeMasks[bottom - top + 1] << top;
+        for (int cx = x0 >> 6; cx <= x1 >> 6; ++cx) {
+            int left = std::max(x0 - cx * CHUNK_SIZE, 0);
+            int right = std::min(x1 - cx * CHUNK_SIZE, CHUNK_SIZE - 1);
+            std::uint64_t rowSpan = shapeMasks[right - left + 1] << left;
+            Chunk& chunk = chunkAt(cx, cy);
+            for (int row = top; row <= bottom; ++row) {
+                chunk.rows[rowIndex(BoardPlane::Forbidden, row)] |= rowSpan;
+            }
+            for (int column = left; column <= right; ++column) {
+                chunk.forbiddenColumns[column] |= columnSpan;
+            }
+        }
+    }
+}
+
+bool BitBoard::planeFull(BoardPlane plane, int cx, int cy) const {
+    const Chunk* chunk = findChunk(cx, cy);
+    if (chunk == nullptr) {
+        return false;
+    }
+    std::uint64_t columns = columnMask(cx);
+    int rows = std::min(CHUNK_SIZE, height - cy * CHUNK_SIZE);
+    for (int row = 0; row < rows; ++row) {
+        if ((chunk->rows[rowIndex(plane, row)] & columns) != columns) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t BitBoard::anchorRow(int cx, int y, int length) const {
+    std::uint64_t first = ~rowWord(BoardPlane::Forbidden, cx, y) & columnMask(cx);
+    std::uint64_t second = static_cast<std::uint64_t>(cx) + 1 < chunksX
+        ? ~rowWord(BoardPlane::Forbidden, cx + 1, y) & columnMask(cx + 1) : 0;
+    return spanStarts(first, second, length);
+}
+
+std::uint64_t BitBoard::anchorColumn(int x, int cy, int length) const {
+    std::uint64_t first = ~columnWord(x, cy) & rowMask(cy);
+    std::uint64_t second = static_cast<std::uint64_t>(cy) + 1 < chunksY
+        ? ~columnWord(x, cy + 1) & rowMask(cy + 1) : 0;
+    return spanStarts(first, second, length);
+}
+
+std::vector<std::uint64_t> BitBoard::activeChunks(BoardPlane plane) const {
+    std::vector<std::uint64_t> keys;
+    for (const Chunk& chunk : chunks) {
+        auto first = chunk.rows.begin() + rowIndex(plane, 0);
+        if (std::any_of(first, first + CHUNK_SIZE, [](std::uint64_t word) { return word != 0; })) {
+            keys.push_back(chunk.key);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+std::uint64_t BitBoard::chunkRow(BoardPlane plane, std::uint64_t key, int row) const {
+    if (key >= chunksX * chunksY || row < 0 || row >= CHUNK_SIZE) {
+        return 0;
+    }
+    const Chunk* chunk = findChunk(static_cast<int>(key % chunksX), static_cast<int>(key / chunksX));
+    return chunk == nullptr ? 0 : chunk->rows[rowIndex(plane, row)];
+}
+
+void BitBoard::setChunkRow(BoardPlane plane, std::uint64_t key, int row, std::uint64_t word) {
+    if (key >= chunksX * chunksY || row < 0 || row >= CHUNK_SIZE) {
+        throw std::out_of_range("Chunk row out of range.");
+    }
+    int cx = static_cast<int>(key % chunksX);
+    int cy = static_cast<int>(key / chunksX);
+    if (cy * CHUNK_SIZE + row >= height) {
+        word = 0;
+    }
+    word &= shapeMasks[std::min(CHUNK_SIZE, width - cx * CHUNK_SIZE)];
+    Chunk* chunk = word != 0 ? &chunkAt(cx, cy) : findChunk(cx, cy);
+    if (chunk != nullptr) {
+        chunk->rows[rowIndex(plane, row)] = word;
+    }
+}
+
+long long BitBoard::count(BoardPlane plane) const {
+    long long total = 0;
+    for (const Chunk& chunk : chunks) {
+        for (int row = 0; row < CHUNK_SIZE; ++row) {
+            total += __builtin_popcountll(chunk.rows[rowIndex(plane, row)]);
+        }
+    }
+    return total;
+}
+
+long long BitBoard::unknownCellsLeft() const {
+    return static_cast<long long>(width) * height - count(BoardPlane::Shot);
+}
+
+long long BitBoard::hitsOutstanding() const {
+    long long total = 0;
+    for (const Chunk& chunk : chunks) {
+        for (int row = 0; row < CHUNK_SIZE; ++row) {
+            total += __builtin_popcountll(chunk.rows[rowIndex(BoardPlane::Ship, row)]
+                                        & chunk.rows[rowIndex(BoardPlane::Shot, row)]
+                                        & ~chunk.rows[rowIndex(BoardPlane::Destroyed, row)]);
+        }
+    }
+    return total;
+}
@@ -0,0 +1,161 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "ship.h"
+
+enum class BoardPlane {
+    Ship,
+    Shot,
+    Miss,
+    Destroyed,
+    Forbidden,
+    Blocked,
+    Count
+};
+
+// Packed bit planes cut into 64x64 chunks. A chunk is allocated only once
+// some plane sets a bit in it, and cells of missing chunks read as zero, so
+// memory follows the ships and shots rather than the board area. Every
+// chunk row is one 64-bit word; bits beyond the board edge stay zero and
+// popcounts are exact. The Forbidden plane holds ship cells dilated by one
+// cell plus any Blocked cell; a column-major copy of it lets vertical ships
+// be checked with the same word masks, and both are updated a word span at
+// a time. anchorRow and anchorColumn give, 64 cells per word, the cells
+// where a ship of a given length fits. Every chunk also has a 16-bit tag
+// per cell, held in an array allocated with the chunk at the same slot, so
+// reading a tag costs the same chunk lookup as reading a bit. Chunks of
+// small boards are found through a dense directory, those of large boards
+// through a hash map. clear() keeps the chunk storage and the map entries,
+// so a cleared board fills up again without allocating.
+class BitBoard {
+public:
+    static constexpr int CHUNK_SIZE = 64;
+
+    BitBoard(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool inBounds(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    bool test(BoardPlane plane, int x, int y) const {
+        const Chunk* chunk = findChunk(x >> 6, y >> 6);
+        return chunk != nullptr && ((chunk->rows[rowIndex(plane, y)] >> (x & 63)) & 1u);
+    }
+    void set(BoardPlane plane, int x, int y) {
+        chunkAt(x >> 6, y >> 6).rows[rowIndex(plane, y)] |= std::uint64_t{1} << (x & 63);
+    }
+    void reset(BoardPlane plane, int x, int y) {
+        Chunk* chunk = findChunk(x >> 6, y >> 6);
+        if (chunk != nullptr) {
+            chunk->rows[rowIndex(plane, y)] &= ~(std::uint64_t{1} << (x & 63));
+        }
+    }
+    void clear();
+
+    std::uint16_t tag(int x, int y) const {
+        int slot = findSlot(x >> 6, y >> 6);
+        return slot < 0 ? 0 : tags[slot][tagIndex(x, y)];
+    }
+    void setTag(int x, int y, std::uint16_t value);
+
+    bool canFitShip(int x, int y, int length, Orientation orientation) const;
+    void markShip(int x, int y, int length, Orientation orientation);
+    void markShipCell(int x, int y);
+    void unmarkShip(int x, int y, int length, Orientation orientation);
+    void blockCell(int x, int y);
+    void rebuildForbidden();
+
+    std::size_t chunkCount() const { return chunks.size(); }
+    std::uint64_t chunkKeyAt(std::size_t slot) const { return chunks[slot].key; }
+    int chunkSlot(int cx, int cy) const { return findSlot(cx, cy); }
+    bool hasChunk(int cx, int cy) const { return findChunk(cx, cy) != nullptr; }
+    bool planeFull(BoardPlane plane, int cx, int cy) const;
+    std::uint64_t anchorRow(int cx, int y, int length) const;
+    std::uint64_t anchorColumn(int x, int cy, int length) const;
+    std::uint64_t getChunkColumns() const { return chunksX; }
+    std::uint64_t getChunkRows() const { return chunksY; }
+    std::uint64_t chunkKey(int cx, int cy) const {
+        return static_cast<std::uint64_t>(cy) * chunksX + static_cast<std::uint64_t>(cx);
+    }
+    std::vector<std::uint64_t> activeChunks(BoardPlane plane) const;
+    std::uint64_t chunkRow(BoardPlane plane, std::uint64_t key, int row) const;
+    void setChunkRow(BoardPlane plane, std::uint64_t key, int row, std::uint64_t word);
+
+    template <typename Visitor>
+    void forEachCell(BoardPlane plane, Visitor visit) const {
+        for (const Chunk& chunk : chunks) {
+            int originX = static_cast<int>(chunk.key % chunksX) * CHUNK_SIZE;
+            int originY = static_cast<int>(chunk.key / chunksX) * CHUNK_SIZE;
+            for (int row = 0; row < CHUNK_SIZE; ++row) {
+                std::uint64_t word = chunk.rows[rowIndex(plane, row)];
+                while (word != 0) {
+                    visit(originX + __builtin_ctzll(word), originY + row);
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
+    long long count(BoardPlane plane) const;
+    long long unknownCellsLeft() const;
+    long long hitsOutstanding() const;
+
+private:
+    static constexpr int PLANE_COUNT = static_cast<int>(BoardPlane::Count);
+    static constexpr std::size_t DIRECTORY_LIMIT = 4096;
+
+    struct Chunk {
+        std::uint64_t key;
+        std::array<std::uint64_t, PLANE_COUNT * CHUNK_SIZE> rows;
+        std::array<std::uint64_t, CHUNK_SIZE> forbiddenColumns;
+    };
+
+    int width;
+    int height;
+    std::uint64_t chunksX;
+    std::uint64_t chunksY;
+    std::vector<Chunk> chunks;
+    std::vector<std::array<std::uint16_t, CHUNK_SIZE * CHUNK_SIZE>> tags;
+    std::vector<int> directory;
+    std::unordered_map<std::uint64_t, int> chunkMap;
+
+    static std::size_t rowIndex(BoardPlane plane, int y) {
+        return static_cast<std::size_t>(plane) * CHUNK_SIZE + (y & 63);
+    }
+    static std::size_t tagIndex(int x, int y) {
+        return static_cast<std::size_t>(y & 63) * CHUNK_SIZE + static_cast<std::size_t>(x & 63);
+    }
+    int findSlot(int cx, int cy) const {
+        std::uint64_t key = chunkKey(cx, cy);
+        if (!directory.empty()) {
+            return directory[key];
+        }
+        auto it = chunkMap.find(key);
+        return it == chunkMap.end() ? -1 : it->second;
+    }
+    const Chunk* findChunk(int cx, int cy) const {
+        int slot = findSlot(cx, cy);
+        return slot < 0 ? nullptr : &chunks[slot];
+    }
+    Chunk* findChunk(int cx, int cy) {
+        return const_cast<Chunk*>(static_cast<const BitBoard*>(this)->findChunk(cx, cy));
+    }
+    Chunk& chunkAt(int cx, int cy);
+
+    std::uint64_t rowWord(BoardPlane plane, int cx, int y) const;
+    std::uint64_t columnWord(int x, int cy) const;
+    std::uint64_t columnMask(int cx) const;
+    std::uint64_t rowMask(int cy) const;
+    std::uint64_t dilatedShipRow(int cx, int y) const;
+    void forbidRect(int x0, int y0, int x1, int y1);
+    void refreshForbidden(int x0, int y0, int x1, int y1);
+};
+
+#endif
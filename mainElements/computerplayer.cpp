@@ -1,24 +1,112 @@
 #include "computerplayer.h"
+#include "../ai/randomTargeting.h"
+#include "../ai/heatmapTargeting.h"
+#include "../ai/monteCarloTargeting.h"
 
-ComputerPlayer::ComputerPlayer(GameField* targetField, ShipManager* enemyShips)
+namespace {
+
+const long long MAX_HEATMAP_CELLS = 1LL << 22;
+
+}
+
+ComputerPlayer::ComputerPlayer(GameField* targetField, ShipManager* enemyShips,
+                               TargetingMode mode, const TargetingSettings& settings,
+                               GameRng rng)
     : targetField(targetField), 
-      enemyShips(enemyShips), 
-      rng(std::random_device{}()) 
+      enemyShips(enemyShips),
+      mode(mode)
 {
+    if (!targetField || !enemyShips) {
+        return;
+    }
+    this->mode = supportedMode(mode, targetField->getWidth(), targetField->getHeight());
+    switch (this->mode) {
+        case TargetingMode::Random:
+            strategy = std::make_unique<RandomTargeting>(*targetField, rng);
+            break;
+        case TargetingMode::HuntTarget:
+            strategy = std::make_unique<HeatmapTargeting>(*targetField, *enemyShips, rng);
+            break;
+        case TargetingMode::MonteCarlo: {
+            std::vector<int> shipSizes = settings.shipSizes;
+            if (shipSizes.empty()) {
+                for (std::size_t i = 0; i < enemyShips->getShipCount(); ++i) {
+                    shipSizes.push_back(enemyShips->getLength(i));
+                }
+            }
+            strategy = std::make_unique<MonteCarloTargeting>(*targetField, *enemyShips, shipSizes,
+                                                             rng, settings.moveBudget,
+                                                             settings.threads);
+            break;
+        }
+    }
+}
+
+TargetingMode ComputerPlayer::supportedMode(TargetingMode requested, int width, int height) {
+    if (static_cast<long long>(width) * height > MAX_HEATMAP_CELLS) {
+        return TargetingMode::Random;
+    }
+    return requested;
 }
 
 bool ComputerPlayer::makeMove() {
-    if (!targetField || !enemyShips) {
+    if (!targetField || !enemyShips || !strategy) {
         return false;
     }
 
-    int x = std::uniform_int_distribution<>(0, targetField->getWidth() - 1)(rng);
-    int y = std::uniform_int_distribution<>(0, targetField->getHeight() - 1)(rng);
+    int x = 0;
+    int y = 0;
+    if (!strategy->chooseTarget(x, y)) {
+        return false;
+    }
 
-    try {
-        targetField->attackCell(x, y, *enemyShips);
-        return true;
-    } catch (const OutOfFieldException&) {
+    AttackResult result = targetField->tryAttack(x, y);
+    if (result.outcome == AttackOutcome::OutOfBounds) {
         return false;
     }
-}
\ No newline at end of file
+    strategy->recordShot(x, y);
+    lastX = x;
+    lastY = y;
+    lastResult = result;
+    return true;
+}
+
+bool ComputerPlayer::replayMove(int x, int y) {
+    if (!targetField || !enemyShips) {
+        return false;
+    }
+
+    if (strategy && strategy->isRepeatable()) {
+        int chosenX = 0;
+        int chosenY = 0;
+        strategy->chooseTarget(chosenX, chosenY);
+    }
+    AttackResult result = targetField->tryAttack(x, y);
+    if (result.outcome == AttackOutcome::OutOfBounds) {
+        return false;
+    }
+    if (strategy) {
+        strategy->recordShot(x, y);
+    }
+    lastX = x;
+    lastY = y;
+    lastResult = result;
+    return true;
+}
+
+void ComputerPlayer::reset(GameRng rng) {
+    lastX = -1;
+    lastY = -1;
+    lastResult = {AttackOutcome::OutOfBounds, -1};
+    if (strategy) {
+        strategy->reset(rng);
+    }
+}
+
+GameRng ComputerPlayer::getRng() const {
+    return strategy ? strategy->getRng() : GameRng();
+}
+
+std::string ComputerPlayer::getStrategyName() const {
+    return strategy ? strategy->getName() : "";
+}
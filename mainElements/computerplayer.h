@@ -3,17 +3,53 @@
 
 #include "gamefield.h"
 #include "shipmanager.h"
-#include <random>
+#include "gamerng.h"
+#include "../ai/targetingStrategy.h"
+#include <chrono>
+#include <memory>
+#include <vector>
+
+enum class TargetingMode {
+    Random,
+    HuntTarget,
+    MonteCarlo
+};
+
+struct TargetingSettings {
+    std::vector<int> shipSizes;
+    std::chrono::milliseconds moveBudget{50};
+    unsigned threads{0};
+};
 
 class ComputerPlayer {
 private:
     GameField* targetField;
     ShipManager* enemyShips;
-    std::mt19937 rng;
+    std::unique_ptr<TargetingStrategy> strategy;
+    TargetingMode mode;
+    int lastX{-1};
+    int lastY{-1};
+    AttackResult lastResult{AttackOutcome::OutOfBounds, -1};
 
 public:
-    ComputerPlayer(GameField* targetField, ShipManager* enemyShips);
+    ComputerPlayer(GameField* targetField, ShipManager* enemyShips,
+                   TargetingMode mode = TargetingMode::Random,
+                   const TargetingSettings& settings = TargetingSettings(),
+                   GameRng rng = GameRng(GameRng::randomSeed()));
     bool makeMove();
+    bool replayMove(int x, int y);
+    void reset(GameRng rng);
+    GameRng getRng() const;
+    int getLastX() const { return lastX; }
+    int getLastY() const { return lastY; }
+    AttackResult getLastResult() const { return lastResult; }
+    std::string getStrategyName() const;
+    TargetingMode getMode() const { return mode; }
+
+    // Hunt/target and Monte Carlo keep several counters per cell, so on
+    // fields above a fixed cell count the computer plays Random instead;
+    // returns the mode a field of this size actually gets.
+    static TargetingMode supportedMode(TargetingMode requested, int width, int height);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,89 @@
+#include "durablefile.h"
+#include <filesystem>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+AppendFile::AppendFile(const std::string& path) : path(path) {
+    file = std::fopen(path.c_str(), "ab");
+    if (file == nullptr) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+}
+
+AppendFile::~AppendFile() {
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+void AppendFile::append(const unsigned char* data, std::size_t size) {
+    if (std::fwrite(data, 1, size, file) != size || std::fflush(file) != 0) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
+void AppendFile::sync() {
+    if (std::fflush(file) != 0) {
+        throw std::runtime_error("Failed to flush file: " + path);
+    }
+}
+
+#else
+
+AppendFile::AppendFile(const std::string& path) : path(path) {
+    fd = ::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+}
+
+AppendFile::~AppendFile() {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void AppendFile::append(const unsigned char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to write file: " + path);
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+void AppendFile::sync() {
+    if (::fsync(fd) != 0) {
+        throw std::runtime_error("Failed to flush file: " + path);
+    }
+}
+
+#endif
+
+void writeFileAtomically(const std::string& path, const std::vector<unsigned char>& bytes) {
+    std::string temporary = path + ".tmp";
+    std::filesystem::remove(temporary);
+    {
+        AppendFile file(temporary);
+        file.append(bytes.data(), bytes.size());
+        file.sync();
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary);
+        throw std::runtime_error("Failed to replace file: " + path);
+    }
+}
@@ -0,0 +1,34 @@
+#ifndef DURABLE_FILE_H
+#define DURABLE_FILE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Write side of the save files. writeFileAtomically fills a temporary
+// sibling, flushes it to disk and renames it over the target, so a crash
+// leaves either the old or the new contents. AppendFile adds bytes to the
+// end of a file with a single write call per append.
+void writeFileAtomically(const std::string& path, const std::vector<unsigned char>& bytes);
+
+class AppendFile {
+public:
+    explicit AppendFile(const std::string& path);
+    ~AppendFile();
+    AppendFile(const AppendFile&) = delete;
+    AppendFile& operator=(const AppendFile&) = delete;
+
+    void append(const unsigned char* data, std::size_t size);
+    void sync();
+
+private:
+    std::string path;
+#ifdef _WIN32
+    std::FILE* file{nullptr};
+#else
+    int fd{-1};
+#endif
+};
+
+#endif
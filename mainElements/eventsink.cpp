@@ -0,0 +1,129 @@
+#include "eventsink.h"
+#include "../abilities/abilityManager.h"
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+const std::chrono::microseconds WRITER_IDLE(200);
+
+}
+
+void formatEvent(std::string& out, const GameEvent& event) {
+    switch (event.type) {
+        case GameEventType::ShotMissed:
+            out += "Miss!\n";
+            break;
+        case GameEventType::ShotHit:
+            out += "Hit!\n";
+            break;
+        case GameEventType::ShipSunk:
+            out += "Ship destroyed!\n";
+            break;
+        case GameEventType::AbilityGranted:
+            if (event.ability) {
+                out += "New ability: ";
+                out += AbilityManager::abilityName(*event.ability);
+                out += '\n';
+            }
+            break;
+        case GameEventType::RoundStarted:
+            out += "\nPreparing for round ";
+            out += std::to_string(event.value);
+            out += "...\n";
+            break;
+        case GameEventType::ScanFound:
+            out += "Ship found at (";
+            out += std::to_string(event.x);
+            out += ',';
+            out += std::to_string(event.y);
+            out += ")\n";
+            break;
+        case GameEventType::ScanEmpty:
+            out += "No ships found in the scanned area.\n";
+            break;
+        case GameEventType::SetupFailed:
+            out += "Error during game initialization";
+            if (!event.message.empty()) {
+                out += ": ";
+                out += event.message;
+            }
+            out += ".\n";
+            break;
+        case GameEventType::TargetingFallback:
+            out += "The ";
+            out += std::to_string(event.x);
+            out += 'x';
+            out += std::to_string(event.y);
+            out += " field is too large for the selected computer strategy, using random targeting.\n";
+            break;
+    }
+}
+
+EventSink& consoleEventSink() {
+    static ConsoleEventSink sink(std::cout);
+    return sink;
+}
+
+EventSink& nullEventSink() {
+    static NullEventSink sink;
+    return sink;
+}
+
+ConsoleEventSink::ConsoleEventSink(std::ostream& os) : os(os) {
+}
+
+void ConsoleEventSink::emit(const GameEvent& event) {
+    std::string buffer;
+    formatEvent(buffer, event);
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+AsyncEventSink::AsyncEventSink(std::ostream& os) : os(os) {
+    writer = std::thread(&AsyncEventSink::writerLoop, this);
+}
+
+AsyncEventSink::~AsyncEventSink() {
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+}
+
+void AsyncEventSink::emit(const GameEvent& event) {
+    while (!ring.push(event)) {
+        std::this_thread::yield();
+    }
+    emitted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AsyncEventSink::flush() {
+    std::uint64_t target = emitted.load(std::memory_order_relaxed);
+    while (written.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+void AsyncEventSink::writerLoop() {
+    std::string batch;
+    GameEvent event;
+    while (true) {
+        std::uint64_t count = 0;
+        while (count < CAPACITY && ring.pop(event)) {
+            formatEvent(batch, event);
+            ++count;
+        }
+        if (count > 0) {
+            os.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            os.flush();
+            batch.clear();
+            written.fetch_add(count, std::memory_order_release);
+            continue;
+        }
+        if (stopping.load(std::memory_order_acquire)) {
+            if (ring.empty()) {
+                break;
+            }
+            continue;
+        }
+        std::this_thread::sleep_for(WRITER_IDLE);
+    }
+}
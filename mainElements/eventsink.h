@@ -0,0 +1,118 @@
+#ifndef EVENT_SINK_H
+#define EVENT_SINK_H
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <thread>
+#include "spscring.h"
+#include "../abilities/ability.h"
+
+enum class GameEventType : std::uint8_t {
+    ShotMissed,
+    ShotHit,
+    ShipSunk,
+    AbilityGranted,
+    RoundStarted,
+    ScanFound,
+    ScanEmpty,
+    SetupFailed,
+    TargetingFallback
+};
+
+// Built through the named factories; ability is only set for ability
+// grants and scans, value holds the ship index or the round number, and
+// message carries the error text of a failed setup.
+struct GameEvent {
+    GameEventType type;
+    std::optional<AbilityType> ability;
+    int x;
+    int y;
+    int value;
+    std::string message;
+
+    static GameEvent shotMissed(int x, int y) {
+        return {GameEventType::ShotMissed, std::nullopt, x, y, -1};
+    }
+    static GameEvent shotHit(int x, int y, int shipIndex) {
+        return {GameEventType::ShotHit, std::nullopt, x, y, shipIndex};
+    }
+    static GameEvent shipSunk(int x, int y, int shipIndex) {
+        return {GameEventType::ShipSunk, std::nullopt, x, y, shipIndex};
+    }
+    static GameEvent abilityGranted(AbilityType type) {
+        return {GameEventType::AbilityGranted, type, 0, 0, -1};
+    }
+    static GameEvent roundStarted(int round) {
+        return {GameEventType::RoundStarted, std::nullopt, 0, 0, round};
+    }
+    static GameEvent scanFound(int x, int y) {
+        return {GameEventType::ScanFound, AbilityType::Scanner, x, y, -1};
+    }
+    static GameEvent scanEmpty(int x, int y) {
+        return {GameEventType::ScanEmpty, AbilityType::Scanner, x, y, -1};
+    }
+    static GameEvent setupFailed(int round, const std::string& message) {
+        return {GameEventType::SetupFailed, std::nullopt, 0, 0, round, message};
+    }
+    static GameEvent targetingFallback(int width, int height) {
+        return {GameEventType::TargetingFallback, std::nullopt, width, height, -1};
+    }
+};
+
+class EventSink {
+public:
+    virtual ~EventSink() = default;
+    virtual void emit(const GameEvent& event) = 0;
+    virtual void flush() {}
+};
+
+class NullEventSink : public EventSink {
+public:
+    void emit(const GameEvent&) override {}
+};
+
+class ConsoleEventSink : public EventSink {
+public:
+    explicit ConsoleEventSink(std::ostream& os);
+    void emit(const GameEvent& event) override;
+
+private:
+    std::ostream& os;
+};
+
+// Formats and writes events on a background thread. The emitting thread
+// only copies the event into a lock-free single-producer ring, waiting
+// when the ring is full rather than dropping events, and the writer batches
+// everything it finds into one write per wake-up. flush() returns once
+// every event emitted so far has been written. Only one thread may emit.
+class AsyncEventSink : public EventSink {
+public:
+    static const std::size_t CAPACITY = 4096;
+
+    explicit AsyncEventSink(std::ostream& os);
+    ~AsyncEventSink() override;
+    AsyncEventSink(const AsyncEventSink&) = delete;
+    AsyncEventSink& operator=(const AsyncEventSink&) = delete;
+
+    void emit(const GameEvent& event) override;
+    void flush() override;
+
+private:
+    std::ostream& os;
+    SpscRing<GameEvent, CAPACITY> ring;
+    std::atomic<std::uint64_t> emitted{0};
+    std::atomic<std::uint64_t> written{0};
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+
+    void writerLoop();
+};
+
+void formatEvent(std::string& out, const GameEvent& event);
+EventSink& consoleEventSink();
+EventSink& nullEventSink();
+
+#endif
@@ -0,0 +1,461 @@
+#include "fleetplacer.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+const long long PROBE_AREA = 4096;
+const int PROBE_ATTEMPTS = 64;
+
+}
+
+FleetPlacer::FleetPlacer(int width, int height)
+    : width(width), height(height), board(width, height) {
+}
+
+bool FleetPlacer::fitsPacking(const std::vector<int>& lengths) const {
+    // Non-touching ships keep disjoint (length + 1) x 2 blocks once each
+    // ship is grown by one cell to the right and below.
+    long long blocks = 0;
+    for (int length : lengths) {
+        if (length < 1) {
+            return false;
+        }
+        blocks += 2LL * (length + 1);
+    }
+    return blocks <= static_cast<long long>(width + 1) * (height + 1);
+}
+
+void FleetPlacer::resetBoard() {
+    path.clear();
+    board.clear();
+    for (int cell : blockedCells) {
+        board.blockCell(cell % width, cell / width);
+    }
+    for (int cell : requiredCells) {
+        board.set(BoardPlane::Destroyed, cell % width, cell / width);
+    }
+    for (std::size_t i = 0; i < anchored.size(); ++i) {
+        board.markShip(anchored[i].x, anchored[i].y, anchoredLengths[i], anchored[i].orientation);
+    }
+}
+
+bool FleetPlacer::coversIntactCell(const ShipPlacement& anchor, int length) const {
+    bool horizontal = anchor.orientation == Orientation::Horizontal;
+    for (int i = 0; i < length; ++i) {
+        if (!board.test(BoardPlane::Destroyed, horizontal ? anchor.x + i : anchor.x,
+                        horizontal ? anchor.y : anchor.y + i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FleetPlacer::anchorRequired(const std::vector<int>& lengths, GameRng& gen,
+                                 std::vector<ShipPlacement>& placements) {
+    freeShips.resize(lengths.size());
+    std::iota(freeShips.begin(), freeShips.end(), 0);
+    if (requiredCells.empty()) {
+        return true;
+    }
+    freeByLength.assign(static_cast<std::size_t>(*std::max_element(lengths.begin(), lengths.end())) + 1, 0);
+    for (int length : lengths) {
+        ++freeByLength[length];
+    }
+
+    // Visits every placement of a free ship length through (x, y) that fits
+    // the board as it stands and keeps an intact segment, weighted by the
+    // free ships of that length.
+    auto forEachCover = [this](int x, int y, auto visit) {
+        for (int length = 1; length < static_cast<int>(freeByLength.size()); ++length) {
+            if (freeByLength[length] == 0) {
+                continue;
+            }
+            for (int i = 0; i < length; ++i) {
+                for (Orientation orientation : {Orientation::Horizontal, Orientation::Vertical}) {
+                    bool horizontal = orientation == Orientation::Horizontal;
+                    ShipPlacement anchor{horizontal ? x - i : x, horizontal ? y : y - i, orientation};
+                    if ((horizontal || length > 1) &&
+                        board.canFitShip(anchor.x, anchor.y, length, orientation) &&
+                        coversIntactCell(anchor, length) && visit(length, anchor, freeByLength[length])) {
+                        return;
+                    }
+                }
+            }
+        }
+    };
+
+    for (int cell : requiredCells) {
+        int x = cell % width;
+        int y = cell / width;
+        if (board.test(BoardPlane::Ship, x, y)) {
+            continue;
+        }
+        long long total = 0;
+        forEachCover(x, y, [&total](int, const ShipPlacement&, int weight) {
+            total += weight;
+            return false;
+        });
+        if (total == 0) {
+            return false;
+        }
+        ++attempts;
+        long long rank = static_cast<long long>(gen.below(static_cast<std::uint64_t>(total)));
+        int length = 0;
+        ShipPlacement anchor{};
+        forEachCover(x, y, [&](int candidateLength, const ShipPlacement& candidate, int weight) {
+            if (rank >= weight) {
+                rank -= weight;
+                return false;
+            }
+            length = candidateLength;
+            anchor = candidate;
+            return true;
+        });
+
+        std::size_t slot = freeShips.size();
+        while (lengths[freeShips[--slot]] != length) {
+        }
+        placements[freeShips[slot]] = anchor;
+        freeShips[slot] = freeShips.back();
+        freeShips.pop_back();
+        --freeByLength[length];
+        board.markShip(anchor.x, anchor.y, length, anchor.orientation);
+        anchored.push_back(anchor);
+        anchoredLengths.push_back(length);
+    }
+    return true;
+}
+
+bool FleetPlacer::probeFleet(const std::vector<int>& lengths, GameRng& gen) {
+    for (int ship : order) {
+        int length = lengths[ship];
+        int spanX = std::max(width - length + 1, 0);
+        int spanY = std::max(height - length + 1, 0);
+        long long horizontal = static_cast<long long>(spanX) * height;
+        long long vertical = length > 1 ? static_cast<long long>(spanY) * width : 0;
+        if (horizontal + vertical == 0) {
+            return false;
+        }
+        bool placed = false;
+        for (int attempt = 0; attempt < PROBE_ATTEMPTS && !placed; ++attempt) {
+            ++attempts;
+            long long rank = static_cast<long long>(gen.below(static_cast<std::uint64_t>(horizontal + vertical)));
+            ShipPlacement anchor;
+            if (rank < horizontal) {
+                anchor = {static_cast<int>(rank % spanX), static_cast<int>(rank / spanX), Orientation::Horizontal};
+            } else {
+                rank -= horizontal;
+                anchor = {static_cast<int>(rank % width), static_cast<int>(rank / width), Orientation::Vertical};
+            }
+            if (board.canFitShip(anchor.x, anchor.y, length, anchor.orientation)) {
+                board.markShip(anchor.x, anchor.y, length, anchor.orientation);
+                path.push_back(anchor);
+                placed = true;
+            }
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::uint64_t FleetPlacer::anchorChunk(const ShipPlacement& anchor) const {
+    return board.chunkKey(anchor.x / BitBoard::CHUNK_SIZE, anchor.y / BitBoard::CHUNK_SIZE);
+}
+
+long long FleetPlacer::chunkAnchors(int cx, int cy, int length) const {
+    if (board.planeFull(BoardPlane::Forbidden, cx, cy)) {
+        return 0;
+    }
+    int originX = cx * BitBoard::CHUNK_SIZE;
+    int originY = cy * BitBoard::CHUNK_SIZE;
+    int rows = std::min(BitBoard::CHUNK_SIZE, height - originY);
+    int columns = std::min(BitBoard::CHUNK_SIZE, width - originX);
+    bool untouched = !board.hasChunk(cx, cy);
+    long long total = 0;
+
+    if (untouched && (static_cast<std::uint64_t>(cx) + 1 >= board.getChunkColumns() ||
+                      !board.hasChunk(cx + 1, cy))) {
+        total += static_cast<long long>(rows) * __builtin_popcountll(board.anchorRow(cx, originY, length));
+    } else {
+        for (int row = 0; row < rows; ++row) {
+            total += __builtin_popcountll(board.anchorRow(cx, originY + row, length));
+        }
+    }
+    if (length == 1) {
+        return total;
+    }
+    if (untouched && (static_cast<std::uint64_t>(cy) + 1 >= board.getChunkRows() ||
+                      !board.hasChunk(cx, cy + 1))) {
+        total += static_cast<long long>(columns) * __builtin_popcountll(board.anchorColumn(originX, cy, length));
+    } else {
+        for (int column = 0; column < columns; ++column) {
+            total += __builtin_popcountll(board.anchorColumn(originX + column, cy, length));
+        }
+    }
+    return total;
+}
+
+long long FleetPlacer::countAnchors(const std::vector<int>& lengths, std::size_t depth) {
+    int length = lengths[order[depth]];
+    excluded.clear();
+    for (std::size_t j = depth + 1; j-- > 0 && lengths[order[j]] == length;) {
+        for (const auto& anchor : exhausted[j]) {
+            if (board.canFitShip(anchor.x, anchor.y, length, anchor.orientation)) {
+                excluded.push_back(anchor);
+            }
+        }
+    }
+    std::sort(excluded.begin(), excluded.end(), [this](const ShipPlacement& a, const ShipPlacement& b) {
+        return anchorChunk(a) < anchorChunk(b);
+    });
+
+    // Chunks that are not untouched interior chunks: allocated chunks, the
+    // chunks whose spans run into them, the last two chunk rows and columns,
+    // and chunks holding excluded anchors.
+    std::uint64_t columns = board.getChunkColumns();
+    std::uint64_t rows = board.getChunkRows();
+    specialChunks.clear();
+    for (std::size_t slot = 0; slot < board.chunkCount(); ++slot) {
+        std::uint64_t key = board.chunkKeyAt(slot);
+        specialChunks.push_back(key);
+        if (key % columns > 0) {
+            specialChunks.push_back(key - 1);
+        }
+        if (key >= columns) {
+            specialChunks.push_back(key - columns);
+        }
+    }
+    for (std::uint64_t cy = 0; cy < rows; ++cy) {
+        for (std::uint64_t cx = columns >= 2 ? columns - 2 : 0; cx < columns; ++cx) {
+            specialChunks.push_back(cy * columns + cx);
+        }
+    }
+    for (std::uint64_t cy = rows >= 2 ? rows - 2 : 0; cy < rows; ++cy) {
+        for (std::uint64_t cx = 0; cx < columns; ++cx) {
+            specialChunks.push_back(cy * columns + cx);
+        }
+    }
+    for (const auto& anchor : excluded) {
+        specialChunks.push_back(anchorChunk(anchor));
+    }
+    std::sort(specialChunks.begin(), specialChunks.end());
+    specialChunks.erase(std::unique(specialChunks.begin(), specialChunks.end()), specialChunks.end());
+
+    long long total = 0;
+    std::size_t next = 0;
+    specialCounts.resize(specialChunks.size());
+    for (std::size_t i = 0; i < specialChunks.size(); ++i) {
+        std::uint64_t key = specialChunks[i];
+        long long count = chunkAnchors(static_cast<int>(key % columns), static_cast<int>(key / columns), length);
+        for (; next < excluded.size() && anchorChunk(excluded[next]) == key; ++next) {
+            --count;
+        }
+        specialCounts[i] = count;
+        total += count;
+    }
+    long long plainChunks = static_cast<long long>(columns * rows - specialChunks.size());
+    return total + plainChunks * BitBoard::CHUNK_SIZE * BitBoard::CHUNK_SIZE * (length > 1 ? 2 : 1);
+}
+
+ShipPlacement FleetPlacer::anchorAt(int length, long long rank) const {
+    const long long chunkCells = BitBoard::CHUNK_SIZE * BitBoard::CHUNK_SIZE;
+    long long perChunk = chunkCells * (length > 1 ? 2 : 1);
+    std::uint64_t columns = board.getChunkColumns();
+    std::uint64_t plain = 0;
+    std::size_t firstExcluded = 0;
+    for (std::size_t i = 0; i <= specialChunks.size(); ++i) {
+        std::uint64_t key = i < specialChunks.size() ? specialChunks[i] : columns * board.getChunkRows();
+        long long plainAnchors = static_cast<long long>(key - plain) * perChunk;
+        if (rank < plainAnchors) {
+            std::uint64_t chunk = plain + static_cast<std::uint64_t>(rank / perChunk);
+            long long offset = rank % perChunk;
+            int originX = static_cast<int>(chunk % columns) * BitBoard::CHUNK_SIZE;
+            int originY = static_cast<int>(chunk / columns) * BitBoard::CHUNK_SIZE;
+            if (offset < chunkCells) {
+                return {originX + static_cast<int>(offset % BitBoard::CHUNK_SIZE),
+                        originY + static_cast<int>(offset / BitBoard::CHUNK_SIZE), Orientation::Horizontal};
+            }
+            offset -= chunkCells;
+            return {originX + static_cast<int>(offset / BitBoard::CHUNK_SIZE),
+                    originY + static_cast<int>(offset % BitBoard::CHUNK_SIZE), Orientation::Vertical};
+        }
+        rank -= plainAnchors;
+        if (i == specialChunks.size()) {
+            break;
+        }
+        std::size_t lastExcluded = firstExcluded;
+        while (lastExcluded < excluded.size() && anchorChunk(excluded[lastExcluded]) == key) {
+            ++lastExcluded;
+        }
+        if (rank < specialCounts[i]) {
+            return chunkAnchorAt(key, length, rank, firstExcluded, lastExcluded);
+        }
+        rank -= specialCounts[i];
+        firstExcluded = lastExcluded;
+        plain = key + 1;
+    }
+    throw std::logic_error("Anchor rank out of range.");
+}
+
+ShipPlacement FleetPlacer::chunkAnchorAt(std::uint64_t key, int length, long long rank,
+                                         std::size_t firstExcluded, std::size_t lastExcluded) const {
+    int cx = static_cast<int>(key % board.getChunkColumns());
+    int cy = static_cast<int>(key / board.getChunkColumns());
+    int originX = cx * BitBoard::CHUNK_SIZE;
+    int originY = cy * BitBoard::CHUNK_SIZE;
+    auto select = [](std::uint64_t word, long long nth) {
+        for (; nth > 0; --nth) {
+            word &= word - 1;
+        }
+        return __builtin_ctzll(word);
+    };
+
+    int rows = std::min(BitBoard::CHUNK_SIZE, height - originY);
+    for (int row = 0; row < rows; ++row) {
+        std::uint64_t word = board.anchorRow(cx, originY + row, length);
+        for (std::size_t i = firstExcluded; i < lastExcluded; ++i) {
+            const ShipPlacement& skip = excluded[i];
+            if (skip.orientation == Orientation::Horizontal && skip.y == originY + row) {
+                word &= ~(std::uint64_t{1} << (skip.x - originX));
+            }
+        }
+        long long count = __builtin_popcountll(word);
+        if (rank < count) {
+            return {originX + select(word, rank), originY + row, Orientation::Horizontal};
+        }
+        rank -= count;
+    }
+    int columns = length > 1 ? std::min(BitBoard::CHUNK_SIZE, width - originX) : 0;
+    for (int column = 0; column < columns; ++column) {
+        std::uint64_t word = board.anchorColumn(originX + column, cy, length);
+        for (std::size_t i = firstExcluded; i < lastExcluded; ++i) {
+            const ShipPlacement& skip = excluded[i];
+            if (skip.orientation == Orientation::Vertical && skip.x == originX + column) {
+                word &= ~(std::uint64_t{1} << (skip.y - originY));
+            }
+        }
+        long long count = __builtin_popcountll(word);
+        if (rank < count) {
+            return {originX + column, originY + select(word, rank), Orientation::Vertical};
+        }
+        rank -= count;
+    }
+    throw std::logic_error("Anchor rank out of range.");
+}
+
+bool FleetPlacer::placeFleet(const std::vector<int>& lengths, GameRng& gen,
+                             std::vector<ShipPlacement>& placements, Deadline deadline) {
+    placements.clear();
+    attempts = 0;
+    restarts = 0;
+    anchored.clear();
+    anchoredLengths.clear();
+    resetBoard();
+    if (!fitsPacking(lengths)) {
+        return false;
+    }
+    placements.resize(lengths.size());
+    if (!anchorRequired(lengths, gen, placements)) {
+        return false;
+    }
+
+    freeLengths.clear();
+    for (int ship : freeShips) {
+        freeLengths.push_back(lengths[ship]);
+    }
+    std::size_t shipCount = freeLengths.size();
+    order.resize(shipCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return freeLengths[a] != freeLengths[b] ? freeLengths[a] > freeLengths[b] : a < b;
+    });
+    if (exhausted.size() < shipCount) {
+        exhausted.resize(shipCount);
+    }
+    if (shipCount == 0) {
+        return true;
+    }
+
+    bool placed = static_cast<long long>(width) * height > PROBE_AREA && probeFleet(freeLengths, gen);
+    if (!placed) {
+        restarts += static_cast<long long>(width) * height > PROBE_AREA;
+        resetBoard();
+        placed = searchFleet(freeLengths, gen, deadline);
+    }
+    if (!placed) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < shipCount; ++i) {
+        placements[freeShips[order[i]]] = path[i];
+    }
+    return true;
+}
+
+bool FleetPlacer::searchFleet(const std::vector<int>& lengths, GameRng& gen, Deadline deadline) {
+    std::size_t shipCount = lengths.size();
+    long long remainingCells = std::accumulate(lengths.begin(), lengths.end(), 0LL);
+    std::size_t depth = 0;
+    unsigned steps = 0;
+    bool timed = deadline != Deadline::max();
+    bool viable = true;
+    exhausted[0].clear();
+    while (true) {
+        if (timed && (++steps & 63) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        long long candidates = viable ? countAnchors(lengths, depth) : 0;
+        if (candidates == 0) {
+            if (depth == 0) {
+                return false;
+            }
+            --depth;
+            ++restarts;
+            const ShipPlacement& last = path.back();
+            board.unmarkShip(last.x, last.y, lengths[order[depth]], last.orientation);
+            remainingCells += lengths[order[depth]];
+            exhausted[depth].push_back(last);
+            path.pop_back();
+            viable = true;
+            continue;
+        }
+
+        ++attempts;
+        int length = lengths[order[depth]];
+        ShipPlacement anchor = anchorAt(length, static_cast<long long>(gen.below(static_cast<std::uint64_t>(candidates))));
+        board.markShip(anchor.x, anchor.y, length, anchor.orientation);
+        path.push_back(anchor);
+        remainingCells -= length;
+        if (++depth == shipCount) {
+            return true;
+        }
+        exhausted[depth].clear();
+        viable = static_cast<long long>(width) * height - board.count(BoardPlane::Forbidden) >= remainingCells;
+    }
+}
+
+bool FleetPlacer::placeFleet(GameField& field, ShipManager& manager, GameRng& gen) {
+    fleetLengths.clear();
+    for (std::size_t i = 0; i < manager.getShipCount(); ++i) {
+        fleetLengths.push_back(manager.getLength(i));
+    }
+    if (!placeFleet(fleetLengths, gen, fleetPlacements)) {
+        return false;
+    }
+
+    if (field.getWidth() == width && field.getHeight() == height) {
+        field.reset();
+    } else {
+        field = GameField(width, height);
+    }
+    field.setShipManager(&manager);
+    for (std::size_t i = 0; i < fleetPlacements.size(); ++i) {
+        const ShipPlacement& placement = fleetPlacements[i];
+        field.placeShip(static_cast<int>(i), placement.x, placement.y, placement.orientation);
+    }
+    return true;
+}
@@ -0,0 +1,94 @@
+#ifndef FLEET_PLACER_H
+#define FLEET_PLACER_H
+
+#include <chrono>
+#include <vector>
+#include "bitboard.h"
+#include "gamerng.h"
+#include "gamefield.h"
+#include "shipmanager.h"
+
+struct ShipPlacement {
+    int x;
+    int y;
+    Orientation orientation;
+};
+
+// Places a fleet by depth-first search: every ship takes an anchor drawn
+// uniformly from the legal anchors left at its depth, and a depth with no
+// anchors left backtracks into the previous ship. The search is exhaustive,
+// so it fails only when no valid layout exists. Anchors already exhausted
+// by an earlier ship of the same length are skipped, since equal ships are
+// interchangeable and that subtree has been searched. Blocked cells never
+// hold a ship; a deadline, when given, aborts the search with a failure.
+// Anchors are never listed one by one: a depth counts the legal anchors of
+// every board chunk a word at a time, treats each untouched chunk away from
+// the board edge as 2 x 64 x 64 free anchors without reading it, and draws
+// a rank into those counts. On large boards each ship first draws a
+// bounded number of anchors uniformly from the in-bounds anchors of both
+// orientations, so each orientation is weighted by its anchor count, and
+// keeps the first legal one: the same uniform draw over legal anchors the
+// search makes. Only a fleet that does not fit that way falls back to the
+// exhaustive search. Required cells hold destroyed segments of ships still
+// afloat: before the rest of the fleet is drawn, each required cell not
+// yet covered gets a ship through it, drawn uniformly from the placements
+// of the free ships that cover it without lying on required cells only,
+// and a cell no free ship can cover fails the call.
+// getAttempts() and getRestarts() report the anchors tried and the
+// backtracks taken by the last placeFleet call.
+class FleetPlacer {
+public:
+    using Deadline = std::chrono::steady_clock::time_point;
+
+    FleetPlacer(int width, int height);
+
+    void blockCell(int cell) { blockedCells.push_back(cell); }
+    void clearBlockedCells() { blockedCells.clear(); }
+    void requireCell(int cell) { requiredCells.push_back(cell); }
+    void clearRequiredCells() { requiredCells.clear(); }
+    bool placeFleet(const std::vector<int>& lengths, GameRng& gen,
+                    std::vector<ShipPlacement>& placements,
+                    Deadline deadline = Deadline::max());
+    bool placeFleet(GameField& field, ShipManager& manager, GameRng& gen);
+    const BitBoard& getBoard() const { return board; }
+    long long getAttempts() const { return attempts; }
+    long long getRestarts() const { return restarts; }
+
+private:
+    int width;
+    int height;
+    BitBoard board;
+    std::vector<int> blockedCells;
+    std::vector<int> requiredCells;
+    std::vector<int> freeShips;
+    std::vector<int> freeLengths;
+    std::vector<int> freeByLength;
+    std::vector<ShipPlacement> anchored;
+    std::vector<int> anchoredLengths;
+    std::vector<int> order;
+    std::vector<int> fleetLengths;
+    std::vector<ShipPlacement> fleetPlacements;
+    std::vector<ShipPlacement> path;
+    std::vector<std::vector<ShipPlacement>> exhausted;
+    std::vector<ShipPlacement> excluded;
+    std::vector<std::uint64_t> specialChunks;
+    std::vector<long long> specialCounts;
+    long long attempts{0};
+    long long restarts{0};
+
+    bool fitsPacking(const std::vector<int>& lengths) const;
+    void resetBoard();
+    bool coversIntactCell(const ShipPlacement& anchor, int length) const;
+    bool anchorRequired(const std::vector<int>& lengths, GameRng& gen,
+                        std::vector<ShipPlacement>& placements);
+    bool probeFleet(const std::vector<int>& lengths, GameRng& gen);
+    bool searchFleet(const std::vector<int>& lengths, GameRng& gen, Deadline deadline);
+    std::uint64_t anchorChunk(const ShipPlacement& anchor) const;
+    long long chunkAnchors(int cx, int cy, int length) const;
+    long long countAnchors(const std::vector<int>& lengths, std::size_t depth);
+    ShipPlacement anchorAt(int length, long long rank) const;
+    ShipPlacement chunkAnchorAt(std::uint64_t key, int length, long long rank,
+                                std::size_t firstExcluded, std::size_t lastExcluded) const;
+};
+
+#endif
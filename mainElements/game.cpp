@@ -1,30 +1,148 @@
 #include "game.h"
+#include "fleetplacer.h"
+#include "metrics.h"
+#include "terminalrenderer.h"
+#include <algorithm>
 #include <fstream>
 
 #include <iostream>
 
-Game::Game(int width, int height)
-    : state(GameStatus::NotStarted),
+Game::Game(int width, int height, const std::vector<int>& sizes, std::uint64_t seed)
+    : seed(seed),
+      rng(seed),
+      events(&consoleEventSink()),
+      state(GameStatus::NotStarted),
       currentRound(0),
       fieldWidth(width),
       fieldHeight(height),
-      shipSizes{4, 3, 3, 2, 2, 2, 1, 1, 1, 1} {
+      shipSizes(sizes),
+      computerMode(TargetingMode::Random),
+      viewX(0),
+      viewY(0),
+      autoPlacePlayer(false),
+      placer(width, height) {
           
     playerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
     computerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
+    computerSettings.shipSizes = shipSizes;
     playerShips = std::make_unique<ShipManager>(shipSizes);
     computerShips = std::make_unique<ShipManager>(shipSizes);
-    playerAbilities = std::make_unique<AbilityManager>();
+    playerAbilities = std::make_unique<AbilityManager>(rng.split());
     
     player = std::make_unique<Player>(computerField.get(), computerShips.get(), playerAbilities.get());
-    computer = std::make_unique<ComputerPlayer>(playerField.get(), playerShips.get());
+    computer = std::make_unique<ComputerPlayer>(playerField.get(), playerShips.get(),
+                                                computerMode, computerSettings, rng.split());
+    attachFields();
+}
+
+const std::vector<int>& Game::defaultShipSizes() {
+    static const std::vector<int> sizes{4, 3, 3, 2, 2, 2, 1, 1, 1, 1};
+    return sizes;
+}
+
+void Game::setShipSizes(const std::vector<int>& sizes) {
+    shipSizes = sizes;
+    computerSettings.shipSizes = sizes;
+}
+
+void Game::attachFields() {
+    playerField->setShipManager(playerShips.get());
+    computerField->setShipManager(computerShips.get());
     computerField->setAbilityManager(playerAbilities.get());
+    computerField->setEventSink(*events);
+    playerField->setEventSink(*events);
+}
+
+void Game::setEventSink(EventSink& sink) {
+    events = &sink;
+    attachFields();
+}
+
+void Game::restoreRng(std::uint64_t savedSeed, const GameRng& savedRng) {
+    seed = savedSeed;
+    rng = savedRng;
+}
+
+void Game::reseed(std::uint64_t newSeed) {
+    seed = newSeed;
+    rng = GameRng(newSeed);
+    playerAbilities->reset(rng.split());
+    computer->reset(rng.split());
+}
+
+void Game::restoreComputerRng(const GameRng& savedRng) {
+    computer->reset(savedRng);
+}
+
+void Game::setComputerTargeting(TargetingMode mode, std::chrono::milliseconds moveBudget) {
+    computerMode = mode;
+    computerSettings.moveBudget = moveBudget;
+    computer = std::make_unique<ComputerPlayer>(playerField.get(), playerShips.get(),
+                                                computerMode, computerSettings, rng.split());
+    if (computer->getMode() != computerMode) {
+        events->emit(GameEvent::targetingFallback(fieldWidth, fieldHeight));
+        events->flush();
+    }
+}
+
+void Game::enableJournal(const std::string& snapshotPath, const std::string& journalPath) {
+    journal.reset();
+    journal = std::make_unique<GameJournal>(*this, snapshotPath, journalPath);
+}
+
+void Game::applyJournalRecord(const JournalRecord& record) {
+    switch (record.type) {
+        case JournalRecordType::PlayerAttack:
+            computerField->setEventSink(nullEventSink());
+            computerField->attackCell(record.x, record.y);
+            attachFields();
+            if (computerShips->allShipsDestroyed()) {
+                state = GameStatus::PlayerWon;
+            }
+            break;
+        case JournalRecordType::ComputerAttack:
+            playerField->setEventSink(nullEventSink());
+            if (!computer->replayMove(record.x, record.y)) {
+                playerField->setEventSink(*events);
+                throw std::runtime_error("Invalid computer move in journal.");
+            }
+            playerField->setEventSink(*events);
+            if (playerShips->allShipsDestroyed()) {
+                state = GameStatus::PlayerLost;
+            }
+            break;
+        case JournalRecordType::AbilityGranted: {
+            AbilityType type;
+            if (!AbilityManager::abilityFromCode(record.ability, type)) {
+                throw std::runtime_error("Invalid ability in journal.");
+            }
+            if (!playerAbilities->hasAbilities() || playerAbilities->at(playerAbilities->size() - 1) != type) {
+                throw std::runtime_error("Journal does not match the snapshot.");
+            }
+            break;
+        }
+        case JournalRecordType::AbilityUsed: {
+            AbilityType type;
+            if (!AbilityManager::abilityFromCode(record.ability, type) ||
+                !playerAbilities->hasAbilities() || playerAbilities->front() != type) {
+                throw std::runtime_error("Journal does not match the snapshot.");
+            }
+            if (type == AbilityType::DoubleDamage) {
+                computerField->setNextAttackDoubleDamage(true);
+            }
+            playerAbilities->discardFirstAbility();
+            break;
+        }
+    }
 }
 
 void Game::startNewGame() {
     currentRound = 1;
     initializeNewRound(false);
     state = GameStatus::InProgress;
+    if (journal) {
+        journal->compact();
+    }
 }
 
 void Game::startNextRound() {
@@ -32,107 +150,103 @@ void Game::startNextRound() {
         return;
     }
     
-    std::cout << "\nPreparing for round " << (currentRound + 1) << "...\n";
-    
-    auto savedPlayerField = std::move(playerField);
-    auto savedPlayerShips = std::move(playerShips);
-    auto savedAbilities = std::move(playerAbilities);
+    events->emit(GameEvent::roundStarted(currentRound + 1));
+    events->flush();
     
     currentRound++;
     
-    computerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
-    computerShips = std::make_unique<ShipManager>(shipSizes);
-    
-    playerField = std::move(savedPlayerField);
-    playerShips = std::move(savedPlayerShips);
-    playerAbilities = std::move(savedAbilities);
-    
-    computerField->setAbilityManager(playerAbilities.get());
-    
-    player = std::make_unique<Player>(computerField.get(), computerShips.get(), playerAbilities.get());
-    computer = std::make_unique<ComputerPlayer>(playerField.get(), playerShips.get());
-    
-    int attempts = 0;
-    const int MAX_PLACEMENT_ATTEMPTS = 100;
+    computerField->reset();
+    computerShips->reset(shipSizes);
+    attachFields();
+    computer->reset(rng.split());
     
-    while (!placeAllShipsRandomly(*computerField, *computerShips)) {
-        attempts++;
-        if (attempts >= MAX_PLACEMENT_ATTEMPTS) {
-            throw std::runtime_error("Failed to place computer ships after maximum attempts");
-        }
-        computerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
-        computerShips = std::make_unique<ShipManager>(shipSizes);
+    if (!placeAllShipsRandomly(*computerField, *computerShips)) {
+        throw std::runtime_error("Failed to place computer ships");
     }
     
     state = GameStatus::InProgress;
+    if (journal) {
+        journal->compact();
+    }
+}
+
+void Game::placePlayerShipsInteractively() {
+    std::cout << "\nPlace your ships!\n";
+    for (size_t i = 0; i < playerShips->getShipCount(); ++i) {
+        Ship ship = playerShips->getShip(i);
+        bool placed = false;
+        
+        std::cout << "\nCurrent field state:\n";
+        displayField(*this, true);
+        
+        while (!placed) {
+            std::cout << "\nPlacing ship of length " << ship.getLength() << "\n";
+            std::cout << "Enter coordinates (x y) and orientation (h/v): ";
+            int x, y;
+            char orientation;
+            
+            if (std::cin >> x >> y >> orientation) {
+                Orientation orient = (orientation == 'h' || orientation == 'H') ? 
+                    Orientation::Horizontal : Orientation::Vertical;
+                    
+                try {
+                    if (x < 0 || x >= fieldWidth || y < 0 || y >= fieldHeight) {
+                        std::cout << "Coordinates out of bounds. Try again.\n";
+                        continue;
+                    }
+                    
+                    if (!playerField->canPlaceShip(ship, x, y, orient)) {
+                        std::cout << "Cannot place ship there. Try again.\n";
+                        continue;
+                    }
+                    
+                    placed = playerField->placeShip(static_cast<int>(i), x, y, orient);
+                    if (!placed) {
+                        std::cout << "Failed to place ship. Try again.\n";
+                    }
+                } catch (const ShipPlacementException&) {
+                    std::cout << "Cannot place ship there. Try again.\n";
+                } catch (const std::exception& e) {
+                    std::cout << "Error: " << e.what() << "\nTry again.\n";
+                }
+            } else {
+                std::cout << "Invalid input. Please enter numbers for coordinates and 'h' or 'v' for orientation.\n";
+                std::cin.clear();
+                std::cin.ignore(10000, '\n');
+            }
+        }
+    }
+    playerField->refreshScanTables();
+    std::cout << "\nAll ships placed successfully!\n";
 }
 
 void Game::initializeNewRound(bool keepPlayerState) {
     try {
         if (!keepPlayerState) {
-            playerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
-            playerShips = std::make_unique<ShipManager>(shipSizes);
-            playerAbilities = std::make_unique<AbilityManager>();
+            playerField->reset();
+            playerShips->reset(shipSizes);
+            playerAbilities->reset(rng.split());
             
-            std::cout << "\nPlace your ships!\n";
-            for (size_t i = 0; i < playerShips->getShips().size(); ++i) {
-                Ship& ship = playerShips->getShip(i);
-                bool placed = false;
-                
-                std::cout << "\nCurrent field state:\n";
-                displayField(*this, true);
-                
-                while (!placed) {
-                    std::cout << "\nPlacing ship of length " << ship.getLength() << "\n";
-                    std::cout << "Enter coordinates (x y) and orientation (h/v): ";
-                    int x, y;
-                    char orientation;
-                    
-                    if (std::cin >> x >> y >> orientation) {
-                        Orientation orient = (orientation == 'h' || orientation == 'H') ? 
-                            Orientation::Horizontal : Orientation::Vertical;
-                            
-                        try {
-                            if (x < 0 || x >= fieldWidth || y < 0 || y >= fieldHeight) {
-                                std::cout << "Coordinates out of bounds. Try again.\n";
-                                continue;
-                            }
-                            
-                            if (!playerField->canPlaceShip(ship, x, y, orient)) {
-                                std::cout << "Cannot place ship there. Try again.\n";
-                                continue;
-                            }
-                            
-                            placed = playerField->placeShip(ship, x, y, orient);
-                            if (!placed) {
-                                std::cout << "Failed to place ship. Try again.\n";
-                            }
-                        } catch (const ShipPlacementException&) {
-                            std::cout << "Cannot place ship there. Try again.\n";
-                        } catch (const std::exception& e) {
-                            std::cout << "Error: " << e.what() << "\nTry again.\n";
-                        }
-                    } else {
-                        std::cout << "Invalid input. Please enter numbers for coordinates and 'h' or 'v' for orientation.\n";
-                        std::cin.clear();
-                        std::cin.ignore(10000, '\n');
-                    }
+            if (autoPlacePlayer) {
+                if (!placeAllShipsRandomly(*playerField, *playerShips)) {
+                    throw std::runtime_error("Failed to place player ships");
                 }
+            } else {
+                placePlayerShipsInteractively();
             }
-            std::cout << "\nAll ships placed successfully!\n";
         }
 
-        computerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
-        computerShips = std::make_unique<ShipManager>(shipSizes);
-        computerField->setAbilityManager(playerAbilities.get());
-        player = std::make_unique<Player>(computerField.get(), computerShips.get(), playerAbilities.get());
-        computer = std::make_unique<ComputerPlayer>(playerField.get(), playerShips.get());
+        computerField->reset();
+        computerShips->reset(shipSizes);
+        attachFields();
+        computer->reset(rng.split());
         if (!placeAllShipsRandomly(*computerField, *computerShips)) {
             throw std::runtime_error("Failed to place computer ships");
         }
         
     } catch (const std::exception& e) {
-        std::cerr << "Error during game initialization: " << e.what() << std::endl;
+        events->emit(GameEvent::setupFailed(currentRound, e.what()));
+        events->flush();
         throw;
     }
 }
@@ -146,62 +260,38 @@ void Game::transferPlayerState(GameField& oldField, AbilityManager& oldAbilities
     }
 }
 
-bool Game::placeShipRandomly(GameField& field, Ship& ship) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    
-    const int MAX_ATTEMPTS = 100;
-    for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
-        Orientation orientation = 
-            (std::uniform_int_distribution<>(0, 1)(gen) == 0) ? 
-            Orientation::Horizontal : Orientation::Vertical;
-        
-        ship.setOrientation(orientation);
-        int maxX = fieldWidth - (orientation == Orientation::Horizontal ? ship.getLength() : 0);
-        int maxY = fieldHeight - (orientation == Orientation::Vertical ? ship.getLength() : 0);
-        
-        if (maxX <= 0 || maxY <= 0) continue;
-        
-        int x = std::uniform_int_distribution<>(0, maxX - 1)(gen);
-        int y = std::uniform_int_distribution<>(0, maxY - 1)(gen);
-        
-        try {
-            if (field.canPlaceShip(ship, x, y, orientation)) {
-                return field.placeShip(ship, x, y, orientation);
-            }
-        } catch (const ShipPlacementException&) {
-            continue; 
-        }
-    }
-    return false;
-}
-
 bool Game::placeAllShipsRandomly(GameField& field, ShipManager& manager) {
-    const int MAX_ATTEMPTS = 100;
-    
-    for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
-        field = GameField(fieldWidth, fieldHeight);
-        
-        bool allShipsPlaced = true;
-        for (size_t i = 0; i < manager.getShips().size(); ++i) {
-            if (!placeShipRandomly(field, manager.getShip(i))) {
-                allShipsPlaced = false;
-                break;
-            }
-        }
-        
-        if (allShipsPlaced) {
-            return true;
-        }
-    }
-    return false;
+    ScopedLatency latency(MetricTimer::FleetPlacement);
+    bool placed = placer.placeFleet(field, manager, rng);
+    field.refreshScanTables();
+    metrics().add(MetricCounter::PlacementAttempts, static_cast<std::uint64_t>(placer.getAttempts()));
+    metrics().add(MetricCounter::PlacementRestarts, static_cast<std::uint64_t>(placer.getRestarts()));
+    return placed;
 }
 
-bool Game::usePlayerAbility() {
+AbilityResult Game::usePlayerAbility(const AbilityRequest& request) {
     if (state != GameStatus::InProgress) {
-        return false;
+        return AbilityResult{request.type};
     }
-    return player->useAbility();
+    bool consumed = playerAbilities->hasAbilities() && playerAbilities->front() == request.type;
+    AbilityType type = request.type;
+    AbilityResult result;
+    {
+        ScopedLatency latency(MetricTimer::AbilityUse);
+        result = player->useAbility(request);
+    }
+    if (result.used && computerShips->allShipsDestroyed()) {
+        state = GameStatus::PlayerWon;
+    }
+    if (journal && consumed) {
+        if (type == AbilityType::Bombard) {
+            journal->compact();
+        } else {
+            journal->append({JournalRecordType::AbilityUsed, static_cast<std::uint8_t>(type), 0, 0});
+        }
+    }
+    events->flush();
+    return result;
 }
 
 bool Game::makePlayerAttack(int x, int y) {
@@ -209,11 +299,29 @@ bool Game::makePlayerAttack(int x, int y) {
         return false;
     }
     
-    bool success = player->attack(x, y);
-        if (success && computerShips->allShipsDestroyed()) {
+    std::size_t abilitiesBefore = playerAbilities->size();
+    AttackResult result;
+    {
+        ScopedLatency latency(MetricTimer::PlayerAttack);
+        result = player->attack(x, y);
+    }
+    if (result.outcome == AttackOutcome::Miss) {
+        metrics().add(MetricCounter::Misses);
+    } else if (result.outcome == AttackOutcome::Hit || result.outcome == AttackOutcome::Sunk) {
+        metrics().add(MetricCounter::Hits);
+    }
+    bool success = result.outcome != AttackOutcome::OutOfBounds;
+    if (success && computerShips->allShipsDestroyed()) {
         state = GameStatus::PlayerWon;
     }
-    
+    if (success && journal) {
+        journal->append({JournalRecordType::PlayerAttack, 0, x, y});
+        if (playerAbilities->size() > abilitiesBefore) {
+            AbilityType granted = playerAbilities->at(playerAbilities->size() - 1);
+            journal->append({JournalRecordType::AbilityGranted, static_cast<std::uint8_t>(granted), 0, 0});
+        }
+    }
+    events->flush();
     return success;
 }
 
@@ -222,12 +330,19 @@ bool Game::makeComputerMove() {
         return false;
     }
     
-    bool success = computer->makeMove();
+    bool success;
+    {
+        ScopedLatency latency(MetricTimer::AiMove);
+        success = computer->makeMove();
+    }
     
     if (success && playerShips->allShipsDestroyed()) {
         state = GameStatus::PlayerLost;
     }
-    
+    if (success && journal) {
+        journal->append({JournalRecordType::ComputerAttack, 0, computer->getLastX(), computer->getLastY()});
+    }
+    events->flush();
     return success;
 }
 
@@ -243,8 +358,8 @@ bool Game::hasPlayerAbility() const {
     return player && player->hasAbilities();
 }
 
-std::string Game::getCurrentPlayerAbilityName() const {
-    return player ? player->getCurrentAbilityName() : "";
+std::string_view Game::getCurrentPlayerAbilityName() const {
+    return player ? player->getCurrentAbilityName() : std::string_view();
 }
 
 CellStatus Game::getPlayerFieldStatus(int x, int y) const {
@@ -259,51 +374,15 @@ bool Game::isGameOver() const {
     return state == GameStatus::PlayerWon || state == GameStatus::PlayerLost;
 }
 
+void Game::setViewport(int x, int y) {
+    viewX = std::max(0, std::min(x, fieldWidth - VIEWPORT_SIZE));
+    viewY = std::max(0, std::min(y, fieldHeight - VIEWPORT_SIZE));
+}
+
 void Game::displayField(const Game& game, bool isPlayerField) const {
-    std::cout << "  ";
-    for (int x = 0; x < fieldWidth; ++x) {
-        std::cout << std::setw(2) << x;
-    }
-    std::cout << "\n";
-
-    for (int y = 0; y < fieldHeight; ++y) {
-        std::cout << std::setw(2) << y;
-        for (int x = 0; x < fieldWidth; ++x) {
-            char symbol = '.';  
-            CellStatus status = isPlayerField ? 
-                playerField->getCellStatus(x, y) : 
-                computerField->getCellStatus(x, y);
-            
-            Ship* ship = isPlayerField ? 
-                playerField->getShip(x, y) : 
-                computerField->getShip(x, y);
-                
-            if (ship != nullptr) {
-                int segmentIndex = isPlayerField ?
-                    playerField->getCell(x, y).segmentIndex :
-                    computerField->getCell(x, y).segmentIndex;
-                
-                SegmentState segmentState = ship->getSegmentState(segmentIndex);
-                
-                switch (segmentState) {
-                    case SegmentState::Intact:
-                        symbol = isPlayerField ? 'S' : '.';  
-                        break;
-                    case SegmentState::Damaged:
-                        symbol = 'X'; 
-                        break;
-                    case SegmentState::Destroyed:
-                        symbol = '#'; 
-                        break;
-                }
-            } else if (status == CellStatus::Empty) {
-                symbol = 'O';  
-            }
-            
-            std::cout << std::setw(2) << symbol;
-        }
-        std::cout << "\n";
-    }
+    std::string out;
+    TerminalRenderer::appendField(out, *this, isPlayerField);
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
 }
 
 void Game::updateGameComponents(
@@ -318,17 +397,24 @@ void Game::updateGameComponents(
     playerShips = std::move(pShips);
     computerShips = std::move(cShips);
     playerAbilities = std::move(pAbilities);
+    if (fieldWidth != playerField->getWidth() || fieldHeight != playerField->getHeight()) {
+        fieldWidth = playerField->getWidth();
+        fieldHeight = playerField->getHeight();
+        placer = FleetPlacer(fieldWidth, fieldHeight);
+    }
+    setViewport(viewX, viewY);
     
     player = std::make_unique<Player>(computerField.get(), computerShips.get(), playerAbilities.get());
-    computer = std::make_unique<ComputerPlayer>(playerField.get(), playerShips.get());
-    computerField->setAbilityManager(playerAbilities.get());
+    computer = std::make_unique<ComputerPlayer>(playerField.get(), playerShips.get(),
+                                                computerMode, computerSettings, rng.fork());
+    attachFields();
+    if (journal) {
+        journal->compact();
+    }
 }
 
 void Game::displayLegend() const {
-    std::cout << "\nLegend:\n";
-    std::cout << "  .  - Unknown cell\n";
-    std::cout << "  O  - Miss\n";
-    std::cout << "  S  - Your ship (only on your field)\n";
-    std::cout << "  X  - Hit\n";
-    std::cout << "  #  - Destroyed segment\n";
+    std::string out;
+    TerminalRenderer::appendLegend(out);
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
 }
@@ -3,8 +3,11 @@
 
 #include "player.h"
 #include "computerplayer.h"
+#include "fleetplacer.h"
 #include "gamefield.h"
 #include "shipmanager.h"
+#include "gamejournal.h"
+#include "gamerng.h"
 #include "../abilities/abilityManager.h"
 #include <memory>
 #include <iomanip>
@@ -25,27 +28,53 @@ private:
     std::unique_ptr<Player> player;
     std::unique_ptr<ComputerPlayer> computer;
     std::unique_ptr<AbilityManager> playerAbilities;
+    std::unique_ptr<GameJournal> journal;
+    std::uint64_t seed;
+    GameRng rng;
+    EventSink* events;
     GameStatus state;
     int currentRound;
     int fieldWidth;
     int fieldHeight;
     std::vector<int> shipSizes;
+    TargetingMode computerMode;
+    TargetingSettings computerSettings;
+    int viewX;
+    int viewY;
+    bool autoPlacePlayer;
+    FleetPlacer placer;
     void initializeNewRound(bool keepPlayerState);
+    void placePlayerShipsInteractively();
     void transferPlayerState(GameField& oldField, AbilityManager& oldAbilities,
                            GameField& newField, AbilityManager& newAbilities);
-    bool placeShipRandomly(GameField& field, Ship& ship);
     bool placeAllShipsRandomly(GameField& field, ShipManager& manager);
+    void attachFields();
 
 public:
-    Game(int width = 10, int height = 10);
+    static const int VIEWPORT_SIZE = 20;
+
+    Game(int width = 10, int height = 10, const std::vector<int>& shipSizes = defaultShipSizes(),
+         std::uint64_t seed = GameRng::randomSeed());
+    static const std::vector<int>& defaultShipSizes();
     const ShipManager* getPlayerShips() const { return playerShips.get(); }
     const ShipManager* getComputerShips() const { return computerShips.get(); }
     const GameField* getPlayerField() const { return playerField.get(); }
     const GameField* getComputerField() const { return computerField.get(); }
     const AbilityManager* getPlayerAbilities() const { return playerAbilities.get(); }
     const std::vector<int>& getShipSizes() const { return shipSizes; }
+    std::uint64_t getSeed() const { return seed; }
+    const GameRng& getRng() const { return rng; }
+    void restoreRng(std::uint64_t seed, const GameRng& rng);
+    void reseed(std::uint64_t seed);
+    GameRng getComputerRng() const { return computer->getRng(); }
+    void restoreComputerRng(const GameRng& rng);
     void setGameStatus(GameStatus status) { state = status; }
     void setCurrentRound(int round) { currentRound = round; }
+    void setShipSizes(const std::vector<int>& sizes);
+    void setEventSink(EventSink& sink);
+    void setAutoPlacement(bool enabled) { autoPlacePlayer = enabled; }
+    void setComputerTargeting(TargetingMode mode,
+                              std::chrono::milliseconds moveBudget = std::chrono::milliseconds(50));
 
     void updateGameComponents(
         std::unique_ptr<GameField> pField,
@@ -54,21 +83,26 @@ public:
         std::unique_ptr<ShipManager> cShips,
         std::unique_ptr<AbilityManager> pAbilities
     );
+    void enableJournal(const std::string& snapshotPath, const std::string& journalPath);
+    void applyJournalRecord(const JournalRecord& record);
     void startNewGame();
     void startNextRound();
-    bool usePlayerAbility();
+    AbilityResult usePlayerAbility(const AbilityRequest& request);
     bool makePlayerAttack(int x, int y);
     bool makeComputerMove();
     GameStatus getGameStatus() const;
     int getCurrentRound() const;
     bool hasPlayerAbility() const;
-    std::string getCurrentPlayerAbilityName() const;
+    std::string_view getCurrentPlayerAbilityName() const;
     CellStatus getPlayerFieldStatus(int x, int y) const;
     CellStatus getComputerFieldStatus(int x, int y) const;
     bool isGameOver() const;
     int getFieldWidth() const { return fieldWidth; }
     int getFieldHeight() const { return fieldHeight; }
     void displayField(const Game& game, bool isPlayerField) const;
+    void setViewport(int x, int y);
+    int getViewportX() const { return viewX; }
+    int getViewportY() const { return viewY; }
     void displayLegend() const;
     bool saveGame(const std::string& filename) const;
     bool loadGame(const std::string& filename);
@@ -1,22 +1,33 @@
 #include "gamefield.h"
 #include "../abilities/abilityManager.h"
+#include <algorithm>
 #include <stdexcept>
-#include <iostream>
 
 GameField::GameField(int width, int height)
-    : width(width), height(height), validation_flag(false) {
+    : width(width), height(height), board(width, height), validation_flag(false) {
     if (width > 0 && height > 0) {
         validation_flag = true;
-        field.resize(height, std::vector<CellInfo>(width));
     }
 }
 
+int GameField::findShip(std::uint16_t code) const {
+    if (code == 0 || fleet == nullptr) {
+        return -1;
+    }
+    std::size_t shipIndex = static_cast<std::size_t>(code >> 2) - 1;
+    if (shipIndex >= fleet->getShipCount()) {
+        return -1;
+    }
+    return static_cast<int>(shipIndex);
+}
+
 void GameField::onShipDestroyed() {
     if (!validation_flag) {
         return;
     }
-    if (abilityManager != nullptr) {
-        abilityManager->addRandomAbility();
+    if (abilityManager != nullptr && abilityManager->addRandomAbility()) {
+        AbilityType granted = abilityManager->at(abilityManager->size() - 1);
+        events->emit(GameEvent::abilityGranted(granted));
     }
 }
 
@@ -24,11 +35,18 @@ bool GameField::isValid() const {
     return validation_flag;
 }
 
-GameField::GameField(const GameField& other) {
+void GameField::reset() {
+    board.clear();
+    nextAttackDoubleDamage = false;
+    scanTables.clear();
+    shipOrigins.clear();
+}
+
+GameField::GameField(const GameField& other) : board(0, 0) {
     copyField(other);
 }
 
-GameField::GameField(GameField&& other) noexcept {
+GameField::GameField(GameField&& other) noexcept : board(0, 0) {
     moveField(other);
 }
 
@@ -52,20 +70,29 @@ GameField::~GameField() {
 void GameField::copyField(const GameField& other) {
     width = other.width;
     height = other.height;
-    field = other.field;
+    board = other.board;
     validation_flag = other.validation_flag;
+    fleet = other.fleet;
+    scanTables = other.scanTables;
+    shipOrigins = other.shipOrigins;
 }
 
 void GameField::moveField(GameField& other) {
     width = other.width;
     height = other.height;
-    field = std::move(other.field);
+    board = std::move(other.board);
     validation_flag = other.validation_flag;
+    fleet = other.fleet;
+    scanTables = std::move(other.scanTables);
+    shipOrigins = std::move(other.shipOrigins);
 
     other.width = 0;
     other.height = 0;
-    other.field.clear();
+    other.board = BitBoard(0, 0);
     other.validation_flag = false;
+    other.fleet = nullptr;
+    other.scanTables.clear();
+    other.shipOrigins.clear();
 }
 
 bool GameField::canPlaceShip(const Ship& ship, int x, int y, Orientation orientation) const {
@@ -73,53 +100,21 @@ bool GameField::canPlaceShip(const Ship& ship, int x, int y, Orientation orienta
         return false;
     }
 
-    int shipLength = ship.getLength();
-
-    for (int i = 0; i < shipLength; ++i) {
-        int xi = x;
-        int yi = y;
-
-        if (orientation == Orientation::Horizontal) {
-            xi += i;
-        } else {
-            yi += i;
-        }
-
-        if (xi < 0 || xi >= width || yi < 0 || yi >= height) {
-            return false;
-        }
-
-        if (field[yi][xi].status == CellStatus::Ship) {
-            return false;
-        }
-
-        for (int dx = -1; dx <= 1; ++dx) {
-            for (int dy = -1; dy <= 1; ++dy) {
-                int xj = xi + dx;
-                int yj = yi + dy;
-
-                if (xj >= 0 && xj < width && yj >= 0 && yj < height) {
-                    if (field[yj][xj].status == CellStatus::Ship) {
-                        return false;
-                    }
-                }
-            }
-        }
-    }
-
-    return true;
+    return board.canFitShip(x, y, ship.getLength(), orientation);
 }
 
-bool GameField::placeShip(Ship& ship, int x, int y, Orientation orientation) {
-    if (!validation_flag || !ship.isValid()) {
+bool GameField::placeShip(int shipIndex, int x, int y, Orientation orientation) {
+    if (!validation_flag || fleet == nullptr || shipIndex < 0 || shipIndex >= MAX_SHIPS ||
+        static_cast<std::size_t>(shipIndex) >= fleet->getShipCount()) {
         throw ShipPlacementException();
     }
-    if (!canPlaceShip(ship, x, y, orientation)) {
+    int shipLength = fleet->getLength(shipIndex);
+    if (!board.canFitShip(x, y, shipLength, orientation)) {
         throw ShipPlacementException();
     }
 
-    int shipLength = ship.getLength();
-    ship.setOrientation(orientation); 
+    fleet->setOrientation(shipIndex, orientation);
+    setShipOrigin(shipIndex, x, y);
     for (int i = 0; i < shipLength; ++i) {
         int xi = x;
         int yi = y;
@@ -130,77 +125,259 @@ bool GameField::placeShip(Ship& ship, int x, int y, Orientation orientation) {
             yi += i;
         }
 
-        field[yi][xi].status = CellStatus::Ship;
-        field[yi][xi].shipPtr = &ship;
-        field[yi][xi].segmentIndex = i;
+        board.setTag(xi, yi, static_cast<std::uint16_t>(((shipIndex + 1) << 2) | i));
+    }
+    board.markShip(x, y, shipLength, orientation);
+    markScanStale(x, y);
+    if (orientation == Orientation::Horizontal) {
+        markScanStale(x + shipLength - 1, y);
+    } else {
+        markScanStale(x, y + shipLength - 1);
     }
 
     return true;
 }
 
 CellStatus GameField::getCellStatus(int x, int y) const {
-    if (!validation_flag) {
+    CellStatus status;
+    if (!tryGetCellStatus(x, y, status)) {
         throw OutOfFieldException();
     }
-    if (x < 0 || x >= width || y < 0 || y >= height) {
-        throw OutOfFieldException();
+    return status;
+}
+
+bool GameField::tryGetCellStatus(int x, int y, CellStatus& status) const {
+    if (!validation_flag || !board.inBounds(x, y)) {
+        return false;
+    }
+    if (board.test(BoardPlane::Ship, x, y)) {
+        status = CellStatus::Ship;
+    } else {
+        status = board.test(BoardPlane::Miss, x, y) ? CellStatus::Empty : CellStatus::Unknown;
+    }
+    return true;
+}
+
+bool GameField::trySegmentState(int x, int y, SegmentState& state) const {
+    if (!validation_flag || !board.inBounds(x, y) || !board.test(BoardPlane::Ship, x, y)) {
+        return false;
+    }
+    std::uint16_t code = board.tag(x, y);
+    int shipIndex = findShip(code);
+    if (shipIndex < 0) {
+        return false;
     }
-    return field[y][x].status;
+    state = fleet->getSegmentState(shipIndex, code & 3);
+    return true;
 }
 
-void GameField::attackCell(int x, int y, ShipManager& shipManager) {
-    if (!validation_flag || !shipManager.isValid()) {
+AttackResult GameField::attackCell(int x, int y) {
+    AttackResult result = tryAttack(x, y);
+    if (result.outcome == AttackOutcome::OutOfBounds) {
         throw OutOfFieldException();
     }
-    if (x < 0 || x >= width || y < 0 || y >= height) {
-        throw OutOfFieldException();
+    return result;
+}
+
+AttackResult GameField::tryAttack(int x, int y) {
+    if (!validation_flag || !fleet || !fleet->isValid() || !board.inBounds(x, y)) {
+        return {AttackOutcome::OutOfBounds, -1};
     }
+    ShipManager& shipManager = *fleet;
     
-    CellInfo& cell = field[y][x];
+    std::uint16_t code = board.tag(x, y);
     bool wasDoubleDamage = nextAttackDoubleDamage; 
     nextAttackDoubleDamage = false;  
+    bool finished = board.test(BoardPlane::Miss, x, y) || board.test(BoardPlane::Destroyed, x, y);
+    board.set(BoardPlane::Shot, x, y);
     
-    if (cell.status == CellStatus::Unknown || cell.status == CellStatus::Empty) {
-        cell.status = CellStatus::Empty;
-        std::cout << "Miss!\n";
-    } else if (cell.status == CellStatus::Ship && cell.shipPtr != nullptr) {
-        int segmentIndex = cell.segmentIndex;
-        int damage = wasDoubleDamage ? 2 : 1;
-        
-        bool wasDestroyedBefore = cell.shipPtr->isDestroyed();
-        shipManager.applyDamageToShip(*cell.shipPtr, static_cast<std::size_t>(segmentIndex), damage);
-        
-        if (cell.shipPtr->isDestroyed() && !wasDestroyedBefore) {
-            std::cout << "Ship destroyed!\n";
-            onShipDestroyed();
-        } else {
-            std::cout << "Hit!\n";
-        }
+    if (!board.test(BoardPlane::Ship, x, y)) {
+        board.set(BoardPlane::Miss, x, y);
+        events->emit(GameEvent::shotMissed(x, y));
+        return {finished ? AttackOutcome::AlreadyShot : AttackOutcome::Miss, -1};
+    }
+    int shipIndex = static_cast<int>(code >> 2) - 1;
+    if (code == 0 || static_cast<std::size_t>(shipIndex) >= shipManager.getShipCount()) {
+        return {finished ? AttackOutcome::AlreadyShot : AttackOutcome::Hit, -1};
+    }
+
+    int segmentIndex = code & 3;
+    int damage = wasDoubleDamage ? 2 : 1;
+    
+    bool sunk = shipManager.applyDamage(static_cast<std::size_t>(shipIndex), segmentIndex, damage);
+    if (shipManager.getSegmentState(static_cast<std::size_t>(shipIndex), segmentIndex) == SegmentState::Destroyed) {
+        board.set(BoardPlane::Destroyed, x, y);
+    }
+    
+    if (sunk) {
+        events->emit(GameEvent::shipSunk(x, y, shipIndex));
+        onShipDestroyed();
+        return {AttackOutcome::Sunk, shipIndex};
+    }
+    events->emit(GameEvent::shotHit(x, y, shipIndex));
+    return {finished ? AttackOutcome::AlreadyShot : AttackOutcome::Hit, shipIndex};
+}
+
+AttackResult GameField::damageSegment(int shipIndex, int segmentIndex, int damage) {
+    if (!validation_flag || !fleet || shipIndex < 0 ||
+        static_cast<std::size_t>(shipIndex) >= fleet->getShipCount() ||
+        static_cast<std::size_t>(shipIndex) >= shipOrigins.size() ||
+        segmentIndex < 0 || segmentIndex >= fleet->getLength(shipIndex)) {
+        return {AttackOutcome::OutOfBounds, -1};
+    }
+    int x = shipOrigins[shipIndex].first;
+    int y = shipOrigins[shipIndex].second;
+    if (fleet->getOrientation(shipIndex) == Orientation::Horizontal) {
+        x += segmentIndex;
+    } else {
+        y += segmentIndex;
+    }
+    std::uint16_t code = static_cast<std::uint16_t>(((shipIndex + 1) << 2) | segmentIndex);
+    if (!board.inBounds(x, y) || board.tag(x, y) != code) {
+        return {AttackOutcome::OutOfBounds, -1};
     }
+    ShipManager& shipManager = *fleet;
+
+    bool sunk = shipManager.applyDamage(static_cast<std::size_t>(shipIndex), segmentIndex, damage);
+    board.set(BoardPlane::Shot, x, y);
+    if (shipManager.getSegmentState(static_cast<std::size_t>(shipIndex), segmentIndex) == SegmentState::Destroyed) {
+        board.set(BoardPlane::Destroyed, x, y);
+    }
+
+    if (sunk) {
+        events->emit(GameEvent::shipSunk(x, y, shipIndex));
+        onShipDestroyed();
+        return {AttackOutcome::Sunk, shipIndex};
+    }
+    return {AttackOutcome::Hit, shipIndex};
 }
 
-const CellInfo& GameField::getCell(int x, int y) const {
+CellInfo GameField::getCell(int x, int y) const {
     if (x < 0 || x >= width || y < 0 || y >= height) {
         throw OutOfFieldException();
     }
-    return field[y][x];
+    std::uint16_t code = board.tag(x, y);
+    CellInfo cell;
+    cell.status = getCellStatus(x, y);
+    if (code != 0) {
+        cell.shipIndex = static_cast<int>(code >> 2) - 1;
+        cell.segmentIndex = code & 3;
+    }
+    return cell;
 }
 
-void GameField::setCellState(int x, int y, CellStatus status, Ship* shipPtr, int segmentIndex) {
+void GameField::setCellState(int x, int y, CellStatus status, int shipIndex, int segmentIndex) {
     if (x < 0 || x >= width || y < 0 || y >= height) {
         throw OutOfFieldException();
     }
-    field[y][x].status = status;
-    field[y][x].shipPtr = shipPtr;
-    field[y][x].segmentIndex = segmentIndex;
+    bool hasSegment = shipIndex >= 0 && shipIndex < MAX_SHIPS &&
+                      segmentIndex >= 0 && segmentIndex < Ship::MAX_LENGTH;
+    std::uint16_t code = hasSegment ? static_cast<std::uint16_t>(((shipIndex + 1) << 2) | segmentIndex) : 0;
+    int codeShip = findShip(code);
+    bool hadShip = board.test(BoardPlane::Ship, x, y);
+    board.reset(BoardPlane::Ship, x, y);
+    board.reset(BoardPlane::Shot, x, y);
+    board.reset(BoardPlane::Miss, x, y);
+    board.reset(BoardPlane::Destroyed, x, y);
+    if (status == CellStatus::Ship) {
+        board.markShipCell(x, y);
+        if (codeShip >= 0 && segmentIndex < fleet->getLength(codeShip)) {
+            bool horizontal = fleet->getOrientation(codeShip) == Orientation::Horizontal;
+            setShipOrigin(codeShip, horizontal ? x - segmentIndex : x,
+                          horizontal ? y : y - segmentIndex);
+            SegmentState segmentState = fleet->getSegmentState(codeShip, segmentIndex);
+            if (segmentState != SegmentState::Intact) {
+                board.set(BoardPlane::Shot, x, y);
+            }
+            if (segmentState == SegmentState::Destroyed) {
+                board.set(BoardPlane::Destroyed, x, y);
+            }
+        }
+    } else if (status == CellStatus::Empty) {
+        board.set(BoardPlane::Shot, x, y);
+        board.set(BoardPlane::Miss, x, y);
+    }
+    if (hadShip && status != CellStatus::Ship) {
+        board.rebuildForbidden();
+    }
+    board.setTag(x, y, code);
+    if (hadShip != (status == CellStatus::Ship)) {
+        markScanStale(x, y);
+    }
 }
 
-Ship* GameField::getShip(int x, int y) {
-    if (!validation_flag) {
-        return nullptr;
+void GameField::restoreShotRow(BoardPlane plane, std::uint64_t chunkKey, int row, std::uint64_t word) {
+    if (plane != BoardPlane::Shot && plane != BoardPlane::Miss && plane != BoardPlane::Destroyed) {
+        throw std::invalid_argument("Only shot planes can be restored");
     }
-    if (x < 0 || x >= width || y < 0 || y >= height) {
-        return nullptr;
+    board.setChunkRow(plane, chunkKey, row, word);
+}
+
+int GameField::getShipIndex(int x, int y) const {
+    if (!validation_flag || x < 0 || x >= width || y < 0 || y >= height) {
+        return -1;
+    }
+    return static_cast<int>(board.tag(x, y) >> 2) - 1;
+}
+
+void GameField::setShipOrigin(int shipIndex, int x, int y) {
+    if (static_cast<std::size_t>(shipIndex) >= shipOrigins.size()) {
+        shipOrigins.resize(fleet->getShipCount());
+    }
+    shipOrigins[shipIndex] = {x, y};
+}
+
+void GameField::markScanStale(int x, int y) {
+    int slot = board.chunkSlot(x / BitBoard::CHUNK_SIZE, y / BitBoard::CHUNK_SIZE);
+    if (slot < 0) {
+        return;
+    }
+    if (static_cast<std::size_t>(slot) >= scanTables.size()) {
+        scanTables.resize(static_cast<std::size_t>(slot) + 1);
+    }
+    scanTables[slot].stale = true;
+}
+
+void GameField::refreshScanTables() {
+    for (std::size_t slot = 0; slot < scanTables.size(); ++slot) {
+        ScanTable& table = scanTables[slot];
+        if (!table.stale) {
+            continue;
+        }
+        std::uint64_t key = board.chunkKeyAt(slot);
+        for (int row = 0; row < BitBoard::CHUNK_SIZE; ++row) {
+            std::uint64_t word = board.chunkRow(BoardPlane::Ship, key, row);
+            std::uint16_t running = 0;
+            for (int column = 0; column < BitBoard::CHUNK_SIZE; ++column) {
+                running += static_cast<std::uint16_t>((word >> column) & 1u);
+                table.sums[(row + 1) * TABLE_SIZE + column + 1] =
+                    static_cast<std::uint16_t>(table.sums[row * TABLE_SIZE + column + 1] + running);
+            }
+        }
+        table.stale = false;
+    }
+}
+
+bool GameField::clipArea(int x, int y, int areaWidth, int areaHeight,
+                         int& x0, int& y0, int& x1, int& y1) const {
+    if (!validation_flag || areaWidth <= 0 || areaHeight <= 0) {
+        return false;
+    }
+    x0 = std::max(x, 0);
+    y0 = std::max(y, 0);
+    x1 = static_cast<int>(std::min<long long>(static_cast<long long>(x) + areaWidth, width));
+    y1 = static_cast<int>(std::min<long long>(static_cast<long long>(y) + areaHeight, height));
+    return x0 < x1 && y0 < y1;
+}
+
+long long GameField::countShipCells(int x, int y, int areaWidth, int areaHeight) const {
+    int x0, y0, x1, y1;
+    if (!clipArea(x, y, areaWidth, areaHeight, x0, y0, x1, y1)) {
+        return 0;
     }
-    return field[y][x].shipPtr;
+    long long total = 0;
+    forEachScanChunk(x0, y0, x1, y1, [&total](int, int, int, int, int, int, long long count) {
+        total += count;
+    });
+    return total;
 }
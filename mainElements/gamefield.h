@@ -1,10 +1,15 @@
 #ifndef GAMEFIELD_H
 #define GAMEFIELD_H
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include "ship.h"
 #include "shipmanager.h"
-#include <map>
+#include "bitboard.h"
+#include "eventsink.h"
 #include "../exceptions/gameExceptions.h"
 
 class AbilityManager;
@@ -15,15 +20,45 @@ enum class CellStatus {
     Ship
 };
 
+enum class AttackOutcome : std::uint8_t {
+    Miss,
+    Hit,
+    Sunk,
+    AlreadyShot,
+    OutOfBounds
+};
+
+struct AttackResult {
+    AttackOutcome outcome;
+    int shipIndex;
+};
+
 struct CellInfo {
     CellStatus status;
-    Ship* shipPtr;
+    int shipIndex;
     int segmentIndex;
-    CellInfo() : status(CellStatus::Unknown), shipPtr(nullptr), segmentIndex(-1) {}
+    CellInfo() : status(CellStatus::Unknown), shipIndex(-1), segmentIndex(-1) {}
 };
 
+// Ship cells are stored as 16-bit BitBoard tags: the low two bits hold the
+// segment index and the rest hold the ship's index in the bound ShipManager
+// plus one, so 0 means no ship. Cell status stays in the BitBoard planes. Ships are
+// resolved and damaged through the bound manager, so a field must be bound
+// with setShipManager before ships are placed on it or attacked.
+//
+// Area scans count ship cells, sunk or afloat, through one summed-area
+// table per 64x64 chunk, so a rectangle costs one lookup per chunk it
+// overlaps. The tables sit in an array indexed by the board's chunk slot,
+// beside the bit planes. Placing a ship or changing a cell's ship bit marks
+// the tables of the chunks it touches as stale, and refreshScanTables
+// rebuilds them once a fleet is in place; until then scans count the stale
+// chunk's rows directly, so scans never write. A scan spanning more chunks
+// than the board holds walks the board's chunk slots in place instead of
+// the chunk grid.
 class GameField {
 public:
+    static const int MAX_SHIPS = (1 << 14) - 1;
+
     GameField(int width, int height);
     GameField(const GameField& other);
     GameField(GameField&& other) noexcept;
@@ -32,19 +67,43 @@ public:
     ~GameField();
 
     bool isValid() const;
-    bool placeShip(Ship& ship, int x, int y, Orientation orientation);
+    void reset();
+    bool placeShip(int shipIndex, int x, int y, Orientation orientation);
     CellStatus getCellStatus(int x, int y) const;
-    void attackCell(int x, int y, ShipManager& shipManager);
-    Ship* getShip(int x, int y); 
+    bool tryGetCellStatus(int x, int y, CellStatus& status) const;
+    bool trySegmentState(int x, int y, SegmentState& state) const;
+    AttackResult attackCell(int x, int y);
+    AttackResult tryAttack(int x, int y);
+    // Damages a segment of a placed ship without a shot at a chosen cell,
+    // as bombard does; the cell, sink event and granted ability follow the
+    // same rules as a hit from tryAttack.
+    AttackResult damageSegment(int shipIndex, int segmentIndex, int damage);
+    int getShipIndex(int x, int y) const;
 
     int getWidth() const { return width; }
     int getHeight() const { return height; }
 
-    const CellInfo& getCell(int x, int y) const;
-    void setCellState(int x, int y, CellStatus status, Ship* shipPtr, int segmentIndex);
+    CellInfo getCell(int x, int y) const;
+    void setCellState(int x, int y, CellStatus status, int shipIndex, int segmentIndex);
 
     bool canPlaceShip(const Ship& ship, int x, int y, Orientation orientation) const;
 
+    void refreshScanTables();
+    long long countShipCells(int x, int y, int areaWidth, int areaHeight) const;
+    template <typename Visitor>
+    void forEachShipCell(int x, int y, int areaWidth, int areaHeight, Visitor visit) const;
+
+    const BitBoard& getBoard() const { return board; }
+    void restoreShotRow(BoardPlane plane, std::uint64_t chunkKey, int row, std::uint64_t word);
+    long long unknownCellsLeft() const { return board.unknownCellsLeft(); }
+    long long hitsOutstanding() const { return board.hitsOutstanding(); }
+
+    void setShipManager(ShipManager* manager) {
+        fleet = manager;
+    }
+    ShipManager* getShipManager() const {
+        return fleet;
+    }
     void setAbilityManager(AbilityManager* manager) {
         if (validation_flag)
             abilityManager = manager;
@@ -55,18 +114,119 @@ public:
     bool isNextAttackDoubleDamage() const {
         return nextAttackDoubleDamage;  
     }
+    void setEventSink(EventSink& sink) {
+        events = &sink;
+    }
+    EventSink& getEventSink() const {
+        return *events;
+    }
 
 private:
+    static const int TABLE_SIZE = BitBoard::CHUNK_SIZE + 1;
+
+    struct ScanTable {
+        bool stale{true};
+        std::array<std::uint16_t, TABLE_SIZE * TABLE_SIZE> sums{};
+    };
+
     int width;
     int height;
-    std::vector<std::vector<CellInfo>> field;
-    std::vector<Ship*> ships; 
+    BitBoard board;
     bool validation_flag;
-    AbilityManager* abilityManager;
+    ShipManager* fleet{nullptr};
+    std::vector<ScanTable> scanTables;
+    std::vector<std::pair<int, int>> shipOrigins;
+    AbilityManager* abilityManager{nullptr};
     void copyField(const GameField& other);
     void moveField(GameField& other);
     bool nextAttackDoubleDamage{false}; 
+    EventSink* events{&consoleEventSink()};
     void onShipDestroyed();
+    int findShip(std::uint16_t code) const;
+    void setShipOrigin(int shipIndex, int x, int y);
+    void markScanStale(int x, int y);
+    bool clipArea(int x, int y, int areaWidth, int areaHeight,
+                  int& x0, int& y0, int& x1, int& y1) const;
+    template <typename Visitor>
+    void forEachScanChunk(int x0, int y0, int x1, int y1, Visitor visit) const;
 };
 
+template <typename Visitor>
+void GameField::forEachScanChunk(int x0, int y0, int x1, int y1, Visitor visit) const {
+    const int size = BitBoard::CHUNK_SIZE;
+    int cx0 = x0 / size;
+    int cy0 = y0 / size;
+    int cx1 = (x1 - 1) / size;
+    int cy1 = (y1 - 1) / size;
+    auto visitChunk = [&](int cx, int cy, int slot) {
+        if (slot < 0 || static_cast<std::size_t>(slot) >= scanTables.size()) {
+            return;
+        }
+        int left = std::max(x0 - cx * size, 0);
+        int top = std::max(y0 - cy * size, 0);
+        int right = std::min(x1 - cx * size, size);
+        int bottom = std::min(y1 - cy * size, size);
+        const ScanTable& table = scanTables[slot];
+        long long count = 0;
+        if (table.stale) {
+            std::uint64_t key = board.chunkKeyAt(static_cast<std::size_t>(slot));
+            std::uint64_t mask = (right == size ? ~std::uint64_t{0}
+                                                : (std::uint64_t{1} << right) - 1) &
+                                 ~((std::uint64_t{1} << left) - 1);
+            for (int row = top; row < bottom; ++row) {
+                count += __builtin_popcountll(board.chunkRow(BoardPlane::Ship, key, row) & mask);
+            }
+        } else {
+            const auto& sums = table.sums;
+            count = static_cast<long long>(sums[bottom * TABLE_SIZE + right]) -
+                    sums[top * TABLE_SIZE + right] - sums[bottom * TABLE_SIZE + left] +
+                    sums[top * TABLE_SIZE + left];
+        }
+        if (count > 0) {
+            visit(cx, cy, left, top, right, bottom, count);
+        }
+    };
+
+    long long spanned = static_cast<long long>(cx1 - cx0 + 1) * (cy1 - cy0 + 1);
+    if (spanned <= static_cast<long long>(board.chunkCount())) {
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                visitChunk(cx, cy, board.chunkSlot(cx, cy));
+            }
+        }
+        return;
+    }
+    for (std::size_t slot = 0; slot < scanTables.size(); ++slot) {
+        std::uint64_t key = board.chunkKeyAt(slot);
+        int cx = static_cast<int>(key % board.getChunkColumns());
+        int cy = static_cast<int>(key / board.getChunkColumns());
+        if (cx >= cx0 && cx <= cx1 && cy >= cy0 && cy <= cy1) {
+            visitChunk(cx, cy, static_cast<int>(slot));
+        }
+    }
+}
+
+template <typename Visitor>
+void GameField::forEachShipCell(int x, int y, int areaWidth, int areaHeight, Visitor visit) const {
+    int x0, y0, x1, y1;
+    if (!clipArea(x, y, areaWidth, areaHeight, x0, y0, x1, y1)) {
+        return;
+    }
+    forEachScanChunk(x0, y0, x1, y1, [&](int cx, int cy, int left, int top, int right, int bottom,
+                                         long long) {
+        std::uint64_t key = board.chunkKey(cx, cy);
+        std::uint64_t mask = (right == BitBoard::CHUNK_SIZE ? ~std::uint64_t{0}
+                                                            : (std::uint64_t{1} << right) - 1) &
+                             ~((std::uint64_t{1} << left) - 1);
+        for (int row = top; row < bottom; ++row) {
+            std::uint64_t word = board.chunkRow(BoardPlane::Ship, key, row) & mask;
+            while (word != 0) {
+                visit(cx * BitBoard::CHUNK_SIZE + __builtin_ctzll(word),
+                      cy * BitBoard::CHUNK_SIZE + row);
+                word &= word - 1;
+            }
+        }
+    });
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "gamejournal.h"
+#include "game.h"
+#include "gamestate.h"
+#include "mappedfile.h"
+#include "metrics.h"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const char JOURNAL_MAGIC[4] = {'B', 'J', 'N', 'L'};
+const std::size_t JOURNAL_HEADER_SIZE = 16;
+const unsigned JOURNAL_VERSION = 1;
+
+std::uint32_t recordChecksum(const unsigned char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void putLittleEndian(unsigned char* out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+}
+
+std::uint64_t getLittleEndian(const unsigned char* data, int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+bool decodeRecord(const unsigned char* data, JournalRecord& record) {
+    if (getLittleEndian(data + 12, 4) != recordChecksum(data, 12)) {
+        return false;
+    }
+    unsigned type = data[0];
+    if (type < static_cast<unsigned>(JournalRecordType::PlayerAttack) ||
+        type > static_cast<unsigned>(JournalRecordType::AbilityUsed)) {
+        return false;
+    }
+    record.type = static_cast<JournalRecordType>(type);
+    record.ability = data[1];
+    record.x = static_cast<std::int32_t>(getLittleEndian(data + 4, 4));
+    record.y = static_cast<std::int32_t>(getLittleEndian(data + 8, 4));
+    return true;
+}
+
+}
+
+GameJournal::GameJournal(Game& game, const std::string& snapshotPath,
+                         const std::string& journalPath)
+    : game(game), snapshotPath(snapshotPath), journalPath(journalPath) {
+    compact();
+}
+
+void GameJournal::append(const JournalRecord& record) {
+    unsigned char bytes[RECORD_SIZE] = {};
+    bytes[0] = static_cast<unsigned char>(record.type);
+    bytes[1] = record.ability;
+    putLittleEndian(bytes + 4, static_cast<std::uint32_t>(record.x), 4);
+    putLittleEndian(bytes + 8, static_cast<std::uint32_t>(record.y), 4);
+    putLittleEndian(bytes + 12, recordChecksum(bytes, 12), 4);
+    {
+        ScopedLatency latency(MetricTimer::JournalAppend);
+        file->append(bytes, RECORD_SIZE);
+    }
+    if (++recordCount >= COMPACT_INTERVAL) {
+        compact();
+    }
+}
+
+void GameJournal::compact() {
+    ScopedLatency latency(MetricTimer::JournalCompact);
+    file.reset();
+    GameState::saveGame(game, snapshotPath, snapshot);
+
+    header.assign(JOURNAL_HEADER_SIZE, 0);
+    std::copy(JOURNAL_MAGIC, JOURNAL_MAGIC + sizeof(JOURNAL_MAGIC), header.begin());
+    putLittleEndian(header.data() + 4, JOURNAL_VERSION, 2);
+    putLittleEndian(header.data() + 8, GameState::snapshotChecksum(snapshotPath), 8);
+    writeFileAtomically(journalPath, header);
+
+    file = std::make_unique<AppendFile>(journalPath);
+    recordCount = 0;
+}
+
+bool GameJournal::recover(Game& game, const std::string& snapshotPath, const std::string& journalPath) {
+    if (!std::filesystem::exists(snapshotPath)) {
+        return false;
+    }
+    GameState::loadGame(game, snapshotPath);
+    if (!std::filesystem::exists(journalPath)) {
+        return true;
+    }
+
+    MappedFile journal(journalPath);
+    const unsigned char* data = journal.data();
+    if (journal.size() < JOURNAL_HEADER_SIZE ||
+        !std::equal(JOURNAL_MAGIC, JOURNAL_MAGIC + sizeof(JOURNAL_MAGIC), reinterpret_cast<const char*>(data)) ||
+        getLittleEndian(data + 4, 2) != JOURNAL_VERSION ||
+        getLittleEndian(data + 8, 8) != GameState::snapshotChecksum(snapshotPath)) {
+        return true;
+    }
+
+    JournalRecord record;
+    for (std::size_t offset = JOURNAL_HEADER_SIZE; offset + RECORD_SIZE <= journal.size(); offset += RECORD_SIZE) {
+        if (!decodeRecord(data + offset, record)) {
+            break;
+        }
+        game.applyJournalRecord(record);
+    }
+    return true;
+}
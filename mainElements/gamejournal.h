@@ -0,0 +1,59 @@
+#ifndef GAME_JOURNAL_H
+#define GAME_JOURNAL_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "durablefile.h"
+
+class Game;
+
+enum class JournalRecordType : std::uint8_t {
+    PlayerAttack = 1,
+    ComputerAttack = 2,
+    AbilityGranted = 3,
+    AbilityUsed = 4
+};
+
+struct JournalRecord {
+    JournalRecordType type;
+    std::uint8_t ability;
+    std::int32_t x;
+    std::int32_t y;
+};
+
+// Write-ahead log of the moves made since the last snapshot. Every record
+// is a fixed 16-byte entry with its own checksum, appended with a single
+// write, so a crash loses at most the record in flight. The journal header
+// carries the checksum of the snapshot it extends. Compaction writes a new
+// snapshot before it replaces the journal, and recovery ignores a journal
+// whose header names a different snapshot. Compaction only serializes the
+// game, it never touches the computer player. Replay runs the recorded
+// computer moves through its strategy, so a recovered game continues with
+// the same choices as the one that wrote the journal; Monte Carlo moves
+// depend on their time budget and only replay the recorded cell.
+class GameJournal {
+public:
+    static const std::size_t RECORD_SIZE = 16;
+    static const std::size_t COMPACT_INTERVAL = 512;
+
+    GameJournal(Game& game, const std::string& snapshotPath, const std::string& journalPath);
+
+    void append(const JournalRecord& record);
+    void compact();
+    std::size_t getRecordCount() const { return recordCount; }
+
+    static bool recover(Game& game, const std::string& snapshotPath, const std::string& journalPath);
+
+private:
+    Game& game;
+    std::string snapshotPath;
+    std::string journalPath;
+    std::unique_ptr<AppendFile> file;
+    std::vector<unsigned char> snapshot;
+    std::vector<unsigned char> header;
+    std::size_t recordCount{0};
+};
+
+#endif
@@ -0,0 +1,88 @@
+#include "gamerng.h"
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+std::uint64_t splitmix64(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+const GameRng::State JUMP = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                             0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+const GameRng::State LONG_JUMP = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+                                  0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+
+}
+
+GameRng::GameRng(std::uint64_t seed) {
+    for (auto& word : state) {
+        word = splitmix64(seed);
+    }
+}
+
+std::uint64_t GameRng::randomSeed() {
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32) ^ rd();
+}
+
+GameRng GameRng::stream(std::uint64_t seed, std::uint64_t index) {
+    return GameRng(seed ^ splitmix64(index));
+}
+
+std::uint64_t GameRng::below(std::uint64_t bound) {
+    if (bound == 0) {
+        return 0;
+    }
+    __uint128_t product = static_cast<__uint128_t>((*this)()) * bound;
+    std::uint64_t low = static_cast<std::uint64_t>(product);
+    if (low < bound) {
+        std::uint64_t threshold = -bound % bound;
+        while (low < threshold) {
+            product = static_cast<__uint128_t>((*this)()) * bound;
+            low = static_cast<std::uint64_t>(product);
+        }
+    }
+    return static_cast<std::uint64_t>(product >> 64);
+}
+
+GameRng GameRng::split() {
+    GameRng stream = *this;
+    jump();
+    return stream;
+}
+
+GameRng GameRng::fork() const {
+    GameRng stream = *this;
+    stream.advance(LONG_JUMP);
+    return stream;
+}
+
+void GameRng::jump() {
+    advance(JUMP);
+}
+
+void GameRng::advance(const State& polynomial) {
+    State next{};
+    for (std::uint64_t word : polynomial) {
+        for (int bit = 0; bit < 64; ++bit) {
+            if ((word >> bit) & 1u) {
+                for (int i = 0; i < 4; ++i) {
+                    next[i] ^= state[i];
+                }
+            }
+            (*this)();
+        }
+    }
+    state = next;
+}
+
+void GameRng::setState(const State& value) {
+    if (value[0] == 0 && value[1] == 0 && value[2] == 0 && value[3] == 0) {
+        throw std::invalid_argument("Random generator state cannot be all zero.");
+    }
+    state = value;
+}
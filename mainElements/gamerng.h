@@ -0,0 +1,68 @@
+#ifndef GAMERNG_H
+#define GAMERNG_H
+
+#include <array>
+#include <cstdint>
+
+// xoshiro256** seeded through splitmix64. It satisfies
+// UniformRandomBitGenerator, so standard distributions accept it, but
+// below() and between() draw bounded values without the division a
+// distribution object pays for (Lemire's multiply-shift rejection).
+// split() hands out the current stream and jumps this generator 2^128
+// draws ahead, so every split stream is independent of the others and of
+// the parent. fork() returns a stream 2^192 draws ahead without moving
+// this generator, for parts rebuilt from restored state. stream() derives
+// the generator of one numbered item, such as one game of a batch, from the
+// seed and the index alone, so items give the same results in any order.
+// The whole state can be read back and restored for saves.
+class GameRng {
+public:
+    using result_type = std::uint64_t;
+    using State = std::array<std::uint64_t, 4>;
+
+    explicit GameRng(std::uint64_t seed = 0);
+
+    static std::uint64_t randomSeed();
+    static GameRng stream(std::uint64_t seed, std::uint64_t index);
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type{0}; }
+
+    result_type operator()() {
+        std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+        std::uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    std::uint64_t below(std::uint64_t bound);
+    int between(int low, int high) {
+        return low + static_cast<int>(below(static_cast<std::uint64_t>(static_cast<long long>(high) - low) + 1));
+    }
+    long long between(long long low, long long high) {
+        return low + static_cast<long long>(below(static_cast<std::uint64_t>(high - low) + 1));
+    }
+    bool coin() { return (*this)() >> 63; }
+
+    GameRng split();
+    GameRng fork() const;
+    void jump();
+
+    const State& getState() const { return state; }
+    void setState(const State& value);
+
+private:
+    State state;
+
+    void advance(const State& polynomial);
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+#endif
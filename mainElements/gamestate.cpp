@@ -1,8 +1,299 @@
 #include "gamestate.h"
+#include "mappedfile.h"
+#include "durablefile.h"
+#include "metrics.h"
 #include <fstream>
+#include <algorithm>
 #include <stdexcept>
 
+namespace {
+
+const char BINARY_MAGIC[4] = {'B', 'S', 'H', 'P'};
+const std::size_t BINARY_HEADER_SIZE = 32;
+const int MAX_FIELD_SIZE = 100000;
+const long long MAX_TEXT_CELLS = 1LL << 22;
+const BoardPlane SHOT_PLANES[] = {BoardPlane::Shot, BoardPlane::Miss, BoardPlane::Destroyed};
+
+std::uint64_t checksum(const unsigned char* data, std::size_t size) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<unsigned char>& out) : out(out) {}
+
+    void u8(unsigned value) { out.push_back(static_cast<unsigned char>(value)); }
+    void u16(unsigned value) { put(value, 2); }
+    void u32(std::uint32_t value) { put(value, 4); }
+    void u64(std::uint64_t value) { put(value, 8); }
+
+private:
+    std::vector<unsigned char>& out;
+
+    void put(std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+        }
+    }
+};
+
+class ByteReader {
+public:
+    ByteReader(const unsigned char* data, std::size_t size) : cursor(data), end(data + size) {}
+
+    unsigned u8() { return *take(1); }
+    unsigned u16() { return static_cast<unsigned>(get(2)); }
+    std::uint32_t u32() { return static_cast<std::uint32_t>(get(4)); }
+    std::uint64_t u64() { return get(8); }
+    const unsigned char* take(std::size_t bytes) {
+        if (static_cast<std::size_t>(end - cursor) < bytes) {
+            throw std::runtime_error("Save file is truncated.");
+        }
+        const unsigned char* start = cursor;
+        cursor += bytes;
+        return start;
+    }
+
+private:
+    const unsigned char* cursor;
+    const unsigned char* end;
+
+    std::uint64_t get(int bytes) {
+        const unsigned char* data = take(bytes);
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+        }
+        return value;
+    }
+};
+
+AbilityType abilityFromCode(unsigned code) {
+    AbilityType type;
+    if (!AbilityManager::abilityFromCode(code, type)) {
+        throw std::runtime_error("Invalid ability code in save file.");
+    }
+    return type;
+}
+
+void addLoadedAbility(AbilityManager& manager, AbilityType type) {
+    if (!manager.addAbility(type)) {
+        throw std::runtime_error("Too many abilities in save file.");
+    }
+}
+
+void writeRng(ByteWriter& writer, const GameRng& rng) {
+    for (std::uint64_t word : rng.getState()) {
+        writer.u64(word);
+    }
+}
+
+GameRng readRng(ByteReader& reader) {
+    GameRng::State state;
+    for (auto& word : state) {
+        word = reader.u64();
+    }
+    GameRng rng;
+    try {
+        rng.setState(state);
+    } catch (const std::invalid_argument&) {
+        throw std::runtime_error("Invalid random generator state in save file.");
+    }
+    return rng;
+}
+
+void validateFieldSize(long long width, long long height) {
+    if (width <= 0 || width > MAX_FIELD_SIZE || height <= 0 || height > MAX_FIELD_SIZE) {
+        throw std::runtime_error("Invalid field size in save file. Valid size is from 1x1 to " +
+                                 std::to_string(MAX_FIELD_SIZE) + "x" + std::to_string(MAX_FIELD_SIZE) + ".");
+    }
+}
+
+void writeShips(ByteWriter& writer, const ShipManager& manager) {
+    writer.u32(static_cast<std::uint32_t>(manager.getShipCount()));
+    for (std::size_t index = 0; index < manager.getShipCount(); ++index) {
+        Ship ship = manager.getShip(index);
+        writer.u8(ship.getLength());
+        writer.u8(static_cast<unsigned>(ship.getOrientation()));
+        unsigned packed = 0;
+        int bits = 0;
+        for (int i = 0; i < ship.getLength(); ++i) {
+            packed |= static_cast<unsigned>(ship.getSegmentState(i)) << bits;
+            bits += 2;
+            if (bits == 8) {
+                writer.u8(packed);
+                packed = 0;
+                bits = 0;
+            }
+        }
+        if (bits > 0) {
+            writer.u8(packed);
+        }
+    }
+}
+
+std::unique_ptr<ShipManager> readShips(ByteReader& reader, const std::vector<int>& shipSizes) {
+    auto manager = std::make_unique<ShipManager>(shipSizes);
+    manager->clearShips();
+    std::uint32_t count = reader.u32();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        int length = static_cast<int>(reader.u8());
+        unsigned orientation = reader.u8();
+        if (orientation > 1) {
+            throw std::runtime_error("Invalid ship orientation in save file.");
+        }
+        Ship ship(length, static_cast<Orientation>(orientation));
+        if (!ship.isValid()) {
+            throw std::runtime_error("Invalid ship length in save file.");
+        }
+        const unsigned char* packed = reader.take((static_cast<std::size_t>(length) * 2 + 7) / 8);
+        for (int j = 0; j < length; ++j) {
+            unsigned segment = (packed[j / 4] >> ((j % 4) * 2)) & 3u;
+            if (segment == static_cast<unsigned>(SegmentState::Damaged)) {
+                ship.applyDamage(j, 1);
+            } else if (segment == static_cast<unsigned>(SegmentState::Destroyed)) {
+                ship.applyDamage(j, 2);
+            }
+        }
+        manager->addShip(ship);
+    }
+    return manager;
+}
+
+void writeField(ByteWriter& writer, const GameField& field, const ShipManager& ships) {
+    writer.u8(field.isNextAttackDoubleDamage() ? 1 : 0);
+
+    struct Anchor {
+        std::uint32_t shipIndex;
+        std::uint32_t x;
+        std::uint32_t y;
+    };
+    std::vector<Anchor> anchors;
+    const BitBoard& board = field.getBoard();
+    board.forEachCell(BoardPlane::Ship, [&](int x, int y) {
+        const CellInfo cell = field.getCell(x, y);
+        if (cell.segmentIndex != 0 || cell.shipIndex < 0 ||
+            static_cast<std::size_t>(cell.shipIndex) >= ships.getShipCount()) {
+            return;
+        }
+        anchors.push_back({static_cast<std::uint32_t>(cell.shipIndex),
+                           static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(y)});
+    });
+    std::sort(anchors.begin(), anchors.end(),
+              [](const Anchor& a, const Anchor& b) { return a.shipIndex < b.shipIndex; });
+    writer.u32(static_cast<std::uint32_t>(anchors.size()));
+    for (const Anchor& anchor : anchors) {
+        writer.u32(anchor.shipIndex);
+        writer.u32(anchor.x);
+        writer.u32(anchor.y);
+    }
+
+    std::vector<std::uint64_t> keys = board.activeChunks(BoardPlane::Shot);
+    writer.u32(static_cast<std::uint32_t>(keys.size()));
+    for (std::uint64_t key : keys) {
+        writer.u64(key);
+        for (BoardPlane plane : SHOT_PLANES) {
+            std::uint64_t rowMask = 0;
+            for (int row = 0; row < BitBoard::CHUNK_SIZE; ++row) {
+                if (board.chunkRow(plane, key, row) != 0) {
+                    rowMask |= std::uint64_t{1} << row;
+                }
+            }
+            writer.u64(rowMask);
+            for (std::uint64_t rows = rowMask; rows != 0; rows &= rows - 1) {
+                writer.u64(board.chunkRow(plane, key, __builtin_ctzll(rows)));
+            }
+        }
+    }
+}
+
+std::unique_ptr<GameField> readField(ByteReader& reader, int width, int height,
+                                     ShipManager& ships) {
+    auto field = std::make_unique<GameField>(width, height);
+    field->setShipManager(&ships);
+    bool doubleDamage = reader.u8() != 0;
+
+    std::uint32_t placed = reader.u32();
+    for (std::uint32_t i = 0; i < placed; ++i) {
+        std::uint32_t shipIndex = reader.u32();
+        int x = static_cast<int>(reader.u32());
+        int y = static_cast<int>(reader.u32());
+        if (shipIndex >= ships.getShipCount()) {
+            throw std::runtime_error("Invalid ship index in save file.");
+        }
+        try {
+            field->placeShip(static_cast<int>(shipIndex), x, y, ships.getOrientation(shipIndex));
+        } catch (const ShipPlacementException&) {
+            throw std::runtime_error("Invalid ship position in save file.");
+        }
+    }
+
+    std::uint32_t chunkCount = reader.u32();
+    for (std::uint32_t i = 0; i < chunkCount; ++i) {
+        std::uint64_t key = reader.u64();
+        for (BoardPlane plane : SHOT_PLANES) {
+            std::uint64_t rowMask = reader.u64();
+            for (std::uint64_t rows = rowMask; rows != 0; rows &= rows - 1) {
+                try {
+                    field->restoreShotRow(plane, key, __builtin_ctzll(rows), reader.u64());
+                } catch (const std::out_of_range&) {
+                    throw std::runtime_error("Invalid board chunk in save file.");
+                }
+            }
+        }
+    }
+    field->refreshScanTables();
+    field->setNextAttackDoubleDamage(doubleDamage);
+    return field;
+}
+
+}
+
 void GameState::saveGame(const Game& game, const std::string& filename) {
+    std::vector<unsigned char> bytes;
+    saveGame(game, filename, bytes);
+}
+
+void GameState::saveGame(const Game& game, const std::string& filename, std::vector<unsigned char>& bytes) {
+    ScopedLatency latency(MetricTimer::Save);
+    GameState state(const_cast<Game*>(&game));
+    state.writeBinary(bytes);
+    writeFileAtomically(filename, bytes);
+}
+
+std::uint64_t GameState::snapshotChecksum(const std::string& filename) {
+    MappedFile file(filename);
+    if (!isBinarySave(file.data(), file.size()) || file.size() < BINARY_HEADER_SIZE) {
+        throw std::runtime_error("Not a binary save file.");
+    }
+    ByteReader header(file.data() + BINARY_HEADER_SIZE - 8, 8);
+    return header.u64();
+}
+
+void GameState::loadGame(Game& game, const std::string& filename) {
+    ScopedLatency latency(MetricTimer::Load);
+    MappedFile file(filename);
+    GameState state(&game);
+    if (isBinarySave(file.data(), file.size())) {
+        state.readBinary(file.data(), file.size());
+        return;
+    }
+
+    std::ifstream ifs(filename);
+    if (!ifs) {
+        throw std::runtime_error("Failed to open file for loading: " + filename);
+    }
+    ifs >> state;
+}
+
+void GameState::exportText(const Game& game, const std::string& filename) {
+    if (static_cast<long long>(game.getFieldWidth()) * game.getFieldHeight() > MAX_TEXT_CELLS) {
+        throw std::runtime_error("Field is too large for text export.");
+    }
     std::ofstream ofs(filename);
     if (!ofs) {
         throw std::runtime_error("Failed to open file for saving: " + filename);
@@ -12,20 +303,129 @@ void GameState::saveGame(const Game& game, const std::string& filename) {
     ofs << state;
 }
 
-void GameState::loadGame(Game& game, const std::string& filename) {
-    std::ifstream ifs(filename);
-    if (!ifs) {
-        throw std::runtime_error("Failed to open file for loading: " + filename);
+bool GameState::isBinarySave(const unsigned char* data, std::size_t size) {
+    return data != nullptr && size >= sizeof(BINARY_MAGIC) &&
+           std::equal(BINARY_MAGIC, BINARY_MAGIC + sizeof(BINARY_MAGIC),
+                      reinterpret_cast<const char*>(data));
+}
+
+void GameState::writeBinary(std::vector<unsigned char>& out) const {
+    if (!game) {
+        throw std::runtime_error("No game associated with GameState");
     }
-    
-    GameState state(&game);
-    ifs >> state;
+
+    out.assign(BINARY_HEADER_SIZE, 0);
+    ByteWriter writer(out);
+    writer.u8(static_cast<unsigned>(game->getGameStatus()));
+    writer.u32(static_cast<std::uint32_t>(game->getCurrentRound()));
+    const auto& shipSizes = game->getShipSizes();
+    writer.u32(static_cast<std::uint32_t>(shipSizes.size()));
+    for (int size : shipSizes) {
+        writer.u8(static_cast<unsigned>(size));
+    }
+
+    writeShips(writer, *game->getPlayerShips());
+    writeShips(writer, *game->getComputerShips());
+    writeField(writer, *game->getPlayerField(), *game->getPlayerShips());
+    writeField(writer, *game->getComputerField(), *game->getComputerShips());
+
+    const AbilityManager& abilities = *game->getPlayerAbilities();
+    writer.u32(static_cast<std::uint32_t>(abilities.size()));
+    for (std::size_t i = 0; i < abilities.size(); ++i) {
+        writer.u8(static_cast<unsigned>(abilities.at(i)));
+    }
+    writer.u64(game->getSeed());
+    writeRng(writer, game->getRng());
+    writeRng(writer, abilities.getRng());
+    writeRng(writer, game->getComputerRng());
+
+    std::size_t payloadSize = out.size() - BINARY_HEADER_SIZE;
+    std::uint64_t payloadChecksum = checksum(out.data() + BINARY_HEADER_SIZE, payloadSize);
+    ByteWriter headerWriter(out);
+    for (char c : BINARY_MAGIC) {
+        headerWriter.u8(static_cast<unsigned char>(c));
+    }
+    headerWriter.u16(BINARY_VERSION);
+    headerWriter.u16(0);
+    headerWriter.u32(static_cast<std::uint32_t>(game->getFieldWidth()));
+    headerWriter.u32(static_cast<std::uint32_t>(game->getFieldHeight()));
+    headerWriter.u64(payloadSize);
+    headerWriter.u64(payloadChecksum);
+    std::copy(out.end() - BINARY_HEADER_SIZE, out.end(), out.begin());
+    out.resize(out.size() - BINARY_HEADER_SIZE);
+}
+
+void GameState::readBinary(const unsigned char* data, std::size_t size) {
+    if (!game) {
+        throw std::runtime_error("No game associated with GameState");
+    }
+    if (!isBinarySave(data, size) || size < BINARY_HEADER_SIZE) {
+        throw std::runtime_error("Not a binary save file.");
+    }
+
+    ByteReader header(data, BINARY_HEADER_SIZE);
+    header.take(sizeof(BINARY_MAGIC));
+    unsigned version = header.u16();
+    if (version != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported save file version: " + std::to_string(version));
+    }
+    header.u16();
+    std::uint32_t fieldWidth = header.u32();
+    std::uint32_t fieldHeight = header.u32();
+    std::uint64_t payloadSize = header.u64();
+    std::uint64_t expectedChecksum = header.u64();
+    validateFieldSize(fieldWidth, fieldHeight);
+    if (payloadSize != size - BINARY_HEADER_SIZE) {
+        throw std::runtime_error("Save file is truncated.");
+    }
+    const unsigned char* payload = data + BINARY_HEADER_SIZE;
+    if (checksum(payload, payloadSize) != expectedChecksum) {
+        throw std::runtime_error("Save file checksum mismatch.");
+    }
+
+    ByteReader reader(payload, payloadSize);
+    unsigned stateInt = reader.u8();
+    int currentRound = static_cast<int>(reader.u32());
+    std::uint32_t shipSizesCount = reader.u32();
+    std::vector<int> shipSizes;
+    for (std::uint32_t i = 0; i < shipSizesCount; ++i) {
+        shipSizes.push_back(static_cast<int>(reader.u8()));
+    }
+
+    auto playerShips = readShips(reader, shipSizes);
+    auto computerShips = readShips(reader, shipSizes);
+    auto playerField = readField(reader, static_cast<int>(fieldWidth), static_cast<int>(fieldHeight),
+                                 *playerShips);
+    auto computerField = readField(reader, static_cast<int>(fieldWidth), static_cast<int>(fieldHeight),
+                                   *computerShips);
+
+    auto playerAbilities = std::make_unique<AbilityManager>();
+    playerAbilities->clearAbilities();
+    std::uint32_t abilityCount = reader.u32();
+    for (std::uint32_t i = 0; i < abilityCount; ++i) {
+        addLoadedAbility(*playerAbilities, abilityFromCode(reader.u8()));
+    }
+    std::uint64_t seed = reader.u64();
+    GameRng rng = readRng(reader);
+    playerAbilities->setRng(readRng(reader));
+    GameRng computerRng = readRng(reader);
+    game->restoreRng(seed, rng);
+
+    game->setShipSizes(shipSizes);
+    game->setGameStatus(static_cast<GameStatus>(stateInt));
+    game->setCurrentRound(currentRound);
+    game->updateGameComponents(
+        std::move(playerField), std::move(computerField),
+        std::move(playerShips), std::move(computerShips),
+        std::move(playerAbilities)
+    );
+    game->restoreComputerRng(computerRng);
 }
 
 void GameState::saveShipManager(std::ostream& os, const ShipManager& manager) const {
-    const auto& ships = manager.getShips();
-    os << ships.size() << '\n';
-    for (const auto& ship : ships) {
+    os << manager.getShipCount() << '\n';
+    for (std::size_t index = 0; index < manager.getShipCount(); ++index) {
+        Ship ship = manager.getShip(index);
         os << ship.getLength() << ' '
            << static_cast<int>(ship.getOrientation()) << ' ';
         for (int i = 0; i < ship.getLength(); ++i) {
@@ -38,8 +438,7 @@ void GameState::saveShipManager(std::ostream& os, const ShipManager& manager) co
 void GameState::loadShipManager(std::istream& is, ShipManager& manager) {
     size_t shipCount;
     is >> shipCount;
-    auto& ships = manager.getShips();
-    ships.clear();
+    manager.clearShips();
     for (size_t i = 0; i < shipCount; ++i) {
         int length, orientationInt;
         is >> length >> orientationInt;
@@ -58,25 +457,16 @@ void GameState::loadShipManager(std::istream& is, ShipManager& manager) {
                     break;
             }
         }
-        ships.push_back(ship);
+        manager.addShip(ship);
     }
 }
 
-void GameState::saveGameField(std::ostream& os, const GameField& field, 
-                            const std::vector<Ship>& ships) const {
-    auto shipPtrToIndex = createShipPtrToIndexMap(ships);
-    
+void GameState::saveGameField(std::ostream& os, const GameField& field) const {
     for (int y = 0; y < field.getHeight(); ++y) {
         for (int x = 0; x < field.getWidth(); ++x) {
-            const auto& cell = field.getCell(x, y);
+            const CellInfo cell = field.getCell(x, y);
             os << static_cast<int>(cell.status) << ' ';
-            
-            int shipIndex = -1;
-            if (cell.shipPtr != nullptr) {
-                auto it = shipPtrToIndex.find(cell.shipPtr);
-                shipIndex = (it != shipPtrToIndex.end()) ? it->second : -1;
-            }
-            os << shipIndex << ' ' << cell.segmentIndex << ' ';
+            os << cell.shipIndex << ' ' << cell.segmentIndex << ' ';
         }
         os << '\n';
     }
@@ -84,22 +474,25 @@ void GameState::saveGameField(std::ostream& os, const GameField& field,
 }
 
 void GameState::loadGameField(std::istream& is, GameField& field,
-                            std::vector<Ship>& ships) {
+                            ShipManager& ships) {
+    field.setShipManager(&ships);
     for (int y = 0; y < field.getHeight(); ++y) {
         for (int x = 0; x < field.getWidth(); ++x) {
             int statusInt, shipIndex, segmentIndex;
             is >> statusInt >> shipIndex >> segmentIndex;
-            
-            Ship* shipPtr = (shipIndex >= 0 && static_cast<size_t>(shipIndex) < ships.size()) 
-                ? &ships[shipIndex] 
-                : nullptr;
-                
+            if (shipIndex < 0 || static_cast<size_t>(shipIndex) >= ships.getShipCount()) {
+                shipIndex = -1;
+            }
+            if (statusInt == static_cast<int>(CellStatus::Unknown) && shipIndex < 0) {
+                continue;
+            }
             field.setCellState(x, y, 
                 static_cast<CellStatus>(statusInt), 
-                shipPtr, 
+                shipIndex, 
                 segmentIndex);
         }
     }
+    field.refreshScanTables();
     
     int nextAttackDoubleDamageInt;
     is >> nextAttackDoubleDamageInt;
@@ -107,14 +500,9 @@ void GameState::loadGameField(std::istream& is, GameField& field,
 }
 
 void GameState::saveAbilityManager(std::ostream& os, const AbilityManager& manager) const {
-    const auto& abilities = manager.getAbilities();
-    os << abilities.size() << '\n';
-    for (const auto& ability : abilities) {
-        if (ability) {
-            os << ability->getName() << '\n';
-        } else {
-            os << "Unknown\n";
-        }
+    os << manager.size() << '\n';
+    for (std::size_t i = 0; i < manager.size(); ++i) {
+        os << AbilityManager::abilityName(manager.at(i)) << '\n';
     }
 }
 
@@ -131,22 +519,13 @@ void GameState::loadAbilityManager(std::istream& is, AbilityManager& manager) {
         std::string abilityName;
         std::getline(is, abilityName);
         
-        if (abilityName != "Double Damage" && 
-            abilityName != "Scanner" && 
-            abilityName != "Bombard") {
+        AbilityType type;
+        if (!AbilityManager::parseAbilityName(abilityName, type)) {
             throw std::runtime_error("Invalid ability name in save file: " + abilityName);
         }
         
-        manager.addAbility(abilityName);
-    }
-}
-
-std::map<const Ship*, int> GameState::createShipPtrToIndexMap(const std::vector<Ship>& ships) const {
-    std::map<const Ship*, int> shipPtrToIndex;
-    for (size_t i = 0; i < ships.size(); ++i) {
-        shipPtrToIndex[&ships[i]] = static_cast<int>(i);
+        addLoadedAbility(manager, type);
     }
-    return shipPtrToIndex;
 }
 
 std::ostream& operator<<(std::ostream& os, const GameState& state) {
@@ -168,8 +547,8 @@ std::ostream& operator<<(std::ostream& os, const GameState& state) {
 
     state.saveShipManager(os, *state.game->getPlayerShips());
     state.saveShipManager(os, *state.game->getComputerShips());
-    state.saveGameField(os, *state.game->getPlayerField(), state.game->getPlayerShips()->getShips());
-    state.saveGameField(os, *state.game->getComputerField(), state.game->getComputerShips()->getShips());
+    state.saveGameField(os, *state.game->getPlayerField());
+    state.saveGameField(os, *state.game->getComputerField());
     state.saveAbilityManager(os, *state.game->getPlayerAbilities());
 
     return os;
@@ -183,8 +562,9 @@ std::istream& operator>>(std::istream& is, GameState& state) {
     int stateInt, currentRound, fieldWidth, fieldHeight;
     is >> stateInt >> currentRound >> fieldWidth >> fieldHeight;
 
-    if (fieldWidth <= 0 || fieldWidth > 10 || fieldHeight <= 0 || fieldHeight > 10) {
-        throw std::runtime_error("Invalid field size in save file. Valid size is 10x10.");
+    validateFieldSize(fieldWidth, fieldHeight);
+    if (static_cast<long long>(fieldWidth) * fieldHeight > MAX_TEXT_CELLS) {
+        throw std::runtime_error("Field is too large for a text save.");
     }
 
     size_t shipSizesCount;
@@ -201,12 +581,13 @@ std::istream& operator>>(std::istream& is, GameState& state) {
 
     auto playerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
     auto computerField = std::make_unique<GameField>(fieldWidth, fieldHeight);
-    state.loadGameField(is, *playerField, playerShips->getShips());
-    state.loadGameField(is, *computerField, computerShips->getShips());
+    state.loadGameField(is, *playerField, *playerShips);
+    state.loadGameField(is, *computerField, *computerShips);
 
     auto playerAbilities = std::make_unique<AbilityManager>();
     state.loadAbilityManager(is, *playerAbilities);
 
+    state.game->setShipSizes(shipSizes);
     state.game->setGameStatus(static_cast<GameStatus>(stateInt));
     state.game->setCurrentRound(currentRound);
     state.game->updateGameComponents(
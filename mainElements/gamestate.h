@@ -1,20 +1,39 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
+#include <cstdint>
+#include <cstddef>
 #include <string>
 #include <memory>
 #include <vector>
-#include <map>
 #include "mainElements/game.h"
 #include "mainElements/gamefield.h"
 #include "mainElements/ship.h"
 #include "mainElements/shipmanager.h"
 #include "abilities/abilityManager.h"
 
+// Saves are binary by default: a fixed header (magic, version, field size,
+// payload size and checksum) followed by the ship tables, ship anchors and
+// the non-empty rows of the shot planes of every board chunk fired at,
+// then the pending abilities, the game seed and the generator states.
+// saveGame leaves the game untouched. The computer player's strategy is not
+// stored: its choices depend only on the board and its generator, so
+// loadGame rebuilds it from the loaded board and the saved generator, and
+// the loaded game makes the same moves as the one that was saved, except
+// under Monte Carlo, whose moves depend on its time budget. Only the
+// current binary version loads; binary files of any other version are
+// rejected. The older whitespace-separated text format is written by
+// exportText and recognised by loadGame.
 class GameState {
 public:
+    static const std::uint16_t BINARY_VERSION = 4;
+
     static void saveGame(const Game& game, const std::string& filename);
+    static void saveGame(const Game& game, const std::string& filename, std::vector<unsigned char>& buffer);
     static void loadGame(Game& game, const std::string& filename);
+    static void exportText(const Game& game, const std::string& filename);
+    static std::uint64_t snapshotChecksum(const std::string& filename);
+    static bool isBinarySave(const unsigned char* data, std::size_t size);
 
     friend std::ostream& operator<<(std::ostream& os, const GameState& state);
     friend std::istream& operator>>(std::istream& is, GameState& state);
@@ -24,14 +43,15 @@ private:
     void saveShipManager(std::ostream& os, const ShipManager& manager) const;
     void loadShipManager(std::istream& is, ShipManager& manager);
     
-    void saveGameField(std::ostream& os, const GameField& field, 
-                      const std::vector<Ship>& ships) const;
+    void saveGameField(std::ostream& os, const GameField& field) const;
     void loadGameField(std::istream& is, GameField& field,
-                      std::vector<Ship>& ships);
+                      ShipManager& ships);
     
     void saveAbilityManager(std::ostream& os, const AbilityManager& manager) const;
     void loadAbilityManager(std::istream& is, AbilityManager& manager);
-    std::map<const Ship*, int> createShipPtrToIndexMap(const std::vector<Ship>& ships) const;
+
+    void writeBinary(std::vector<unsigned char>& out) const;
+    void readBinary(const unsigned char* data, std::size_t size);
     explicit GameState(Game* game = nullptr) : game(game) {}
 };
 
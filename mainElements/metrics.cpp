@@ -0,0 +1,228 @@
+#include "metrics.h"
+#include "durablefile.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const double PERCENTILES[] = {0.5, 0.9, 0.99};
+
+double toMicroseconds(std::uint64_t nanoseconds) {
+    return nanoseconds / 1000.0;
+}
+
+}
+
+int LatencyHistogram::bucketIndex(std::uint64_t value) {
+    if (value < static_cast<std::uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(value);
+    }
+    int magnitude = 63 - __builtin_clzll(value);
+    int shift = magnitude - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<int>((value >> shift) & (SUB_BUCKETS - 1));
+}
+
+std::uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<std::uint64_t>(index);
+    }
+    int shift = index / SUB_BUCKETS - 1;
+    std::uint64_t lower = static_cast<std::uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+    buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+    sumNs.fetch_add(nanoseconds, std::memory_order_relaxed);
+    std::uint64_t seen = maxNs.load(std::memory_order_relaxed);
+    while (seen < nanoseconds && !maxNs.compare_exchange_weak(seen, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t LatencyHistogram::percentile(double fraction) const {
+    std::uint64_t recorded = count();
+    if (recorded == 0) {
+        return 0;
+    }
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(fraction * recorded));
+    rank = rank == 0 ? 1 : rank;
+    std::uint64_t seen = 0;
+    for (int i = 0; i < BUCKETS; ++i) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max());
+        }
+    }
+    return max();
+}
+
+void Metrics::add(MetricCounter counter, std::uint64_t amount) {
+    counters[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Metrics::record(MetricTimer timer, std::chrono::nanoseconds elapsed) {
+    timers[static_cast<std::size_t>(timer)].record(static_cast<std::uint64_t>(std::max<long long>(elapsed.count(), 0)));
+}
+
+std::uint64_t Metrics::get(MetricCounter counter) const {
+    return counters[static_cast<std::size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+const LatencyHistogram& Metrics::histogram(MetricTimer timer) const {
+    return timers[static_cast<std::size_t>(timer)];
+}
+
+std::string_view Metrics::counterName(MetricCounter counter) {
+    switch (counter) {
+        case MetricCounter::PlacementAttempts: return "placement_attempts";
+        case MetricCounter::PlacementRestarts: return "placement_restarts";
+        case MetricCounter::Hits: return "hits";
+        case MetricCounter::Misses: return "misses";
+    }
+    return "unknown";
+}
+
+std::string_view Metrics::timerName(MetricTimer timer) {
+    switch (timer) {
+        case MetricTimer::PlayerAttack: return "player_attack";
+        case MetricTimer::FleetPlacement: return "fleet_placement";
+        case MetricTimer::AiMove: return "ai_move";
+        case MetricTimer::AbilityUse: return "ability_use";
+        case MetricTimer::Save: return "save";
+        case MetricTimer::Load: return "load";
+        case MetricTimer::JournalAppend: return "journal_append";
+        case MetricTimer::JournalCompact: return "journal_compact";
+        case MetricTimer::ServerCommand: return "server_command";
+    }
+    return "unknown";
+}
+
+void Metrics::writeText(std::ostream& os) const {
+    os << "Counters:\n";
+    for (std::size_t i = 0; i < COUNTERS; ++i) {
+        MetricCounter counter = static_cast<MetricCounter>(i);
+        os << "  " << std::left << std::setw(20) << counterName(counter) << std::right << get(counter) << "\n";
+    }
+    os << "Latency in microseconds:\n"
+       << "  " << std::left << std::setw(20) << "" << std::right
+       << std::setw(8) << "count" << std::setw(12) << "p50" << std::setw(12) << "p90"
+       << std::setw(12) << "p99" << std::setw(12) << "max" << "\n"
+       << std::fixed << std::setprecision(1);
+    for (std::size_t i = 0; i < TIMERS; ++i) {
+        MetricTimer timer = static_cast<MetricTimer>(i);
+        const LatencyHistogram& h = histogram(timer);
+        os << "  " << std::left << std::setw(20) << timerName(timer) << std::right
+           << std::setw(8) << h.count();
+        for (double fraction : PERCENTILES) {
+            os << std::setw(12) << toMicroseconds(h.percentile(fraction));
+        }
+        os << std::setw(12) << toMicroseconds(h.max()) << "\n";
+    }
+    os << std::defaultfloat;
+}
+
+void Metrics::writeJson(std::ostream& os) const {
+    os << "{\n  \"counters\": {";
+    for (std::size_t i = 0; i < COUNTERS; ++i) {
+        MetricCounter counter = static_cast<MetricCounter>(i);
+        os << (i ? ", " : "") << "\"" << counterName(counter) << "\": " << get(counter);
+    }
+    os << "},\n  \"timers\": {\n";
+    for (std::size_t i = 0; i < TIMERS; ++i) {
+        MetricTimer timer = static_cast<MetricTimer>(i);
+        const LatencyHistogram& h = histogram(timer);
+        os << "    \"" << timerName(timer) << "\": {\"count\": " << h.count()
+           << ", \"sum_ns\": " << h.sum()
+           << ", \"p50_ns\": " << h.percentile(0.5)
+           << ", \"p90_ns\": " << h.percentile(0.9)
+           << ", \"p99_ns\": " << h.percentile(0.99)
+           << ", \"max_ns\": " << h.max() << "}"
+           << (i + 1 < TIMERS ? "," : "") << "\n";
+    }
+    os << "  }\n}\n";
+}
+
+void Metrics::writePrometheus(std::ostream& os) const {
+    for (std::size_t i = 0; i < COUNTERS; ++i) {
+        MetricCounter counter = static_cast<MetricCounter>(i);
+        os << "# TYPE battleship_" << counterName(counter) << "_total counter\n"
+           << "battleship_" << counterName(counter) << "_total " << get(counter) << "\n";
+    }
+    os << std::setprecision(9);
+    for (std::size_t i = 0; i < TIMERS; ++i) {
+        MetricTimer timer = static_cast<MetricTimer>(i);
+        const LatencyHistogram& h = histogram(timer);
+        std::string name = "battleship_" + std::string(timerName(timer)) + "_seconds";
+        os << "# TYPE " << name << " summary\n";
+        for (double fraction : PERCENTILES) {
+            os << name << "{quantile=\"" << fraction << "\"} " << h.percentile(fraction) / 1e9 << "\n";
+        }
+        os << name << "_sum " << h.sum() / 1e9 << "\n"
+           << name << "_count " << h.count() << "\n";
+    }
+    os << std::defaultfloat << std::setprecision(6);
+}
+
+ScopedLatency::ScopedLatency(MetricTimer timer)
+    : timer(timer), start(std::chrono::steady_clock::now()) {
+}
+
+ScopedLatency::~ScopedLatency() {
+    metrics().record(timer, std::chrono::steady_clock::now() - start);
+}
+
+MetricsDumper::MetricsDumper(const std::string& path, std::chrono::seconds interval, MetricsFormat format)
+    : path(path), interval(interval), format(format) {
+    if (interval.count() <= 0) {
+        throw std::invalid_argument("Metrics dump interval must be positive");
+    }
+    dumpNow();
+    worker = std::thread(&MetricsDumper::run, this);
+}
+
+MetricsDumper::~MetricsDumper() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+    try {
+        dumpNow();
+    } catch (const std::exception&) {
+    }
+}
+
+void MetricsDumper::dumpNow() {
+    std::ostringstream out;
+    if (format == MetricsFormat::Json) {
+        metrics().writeJson(out);
+    } else {
+        metrics().writePrometheus(out);
+    }
+    std::string text = out.str();
+    writeFileAtomically(path, std::vector<unsigned char>(text.begin(), text.end()));
+}
+
+void MetricsDumper::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+        lock.unlock();
+        try {
+            dumpNow();
+        } catch (const std::exception&) {
+        }
+        lock.lock();
+    }
+}
+
+Metrics& metrics() {
+    static Metrics instance;
+    return instance;
+}
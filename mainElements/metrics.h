@@ -0,0 +1,125 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+enum class MetricCounter : std::uint8_t {
+    PlacementAttempts,
+    PlacementRestarts,
+    Hits,
+    Misses
+};
+
+enum class MetricTimer : std::uint8_t {
+    PlayerAttack,
+    FleetPlacement,
+    AiMove,
+    AbilityUse,
+    Save,
+    Load,
+    JournalAppend,
+    JournalCompact,
+    ServerCommand
+};
+
+enum class MetricsFormat {
+    Json,
+    Prometheus
+};
+
+// Log-linear latency histogram in the style of HdrHistogram: every power of
+// two is split into eight buckets, so any recorded value lands in a bucket
+// at most 12.5% wide. Recording is a few relaxed atomic adds and is safe
+// from any thread. Percentiles report the upper edge of their bucket.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 3;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void record(std::uint64_t nanoseconds);
+    std::uint64_t count() const { return total.load(std::memory_order_relaxed); }
+    std::uint64_t sum() const { return sumNs.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return maxNs.load(std::memory_order_relaxed); }
+    std::uint64_t percentile(double fraction) const;
+
+    static int bucketIndex(std::uint64_t value);
+    static std::uint64_t bucketUpperBound(int index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKETS> buckets{};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> sumNs{0};
+    std::atomic<std::uint64_t> maxNs{0};
+};
+
+class Metrics {
+public:
+    static const std::size_t COUNTERS = 4;
+    static const std::size_t TIMERS = 9;
+
+    void add(MetricCounter counter, std::uint64_t amount = 1);
+    void record(MetricTimer timer, std::chrono::nanoseconds elapsed);
+    std::uint64_t get(MetricCounter counter) const;
+    const LatencyHistogram& histogram(MetricTimer timer) const;
+
+    void writeText(std::ostream& os) const;
+    void writeJson(std::ostream& os) const;
+    void writePrometheus(std::ostream& os) const;
+
+    static std::string_view counterName(MetricCounter counter);
+    static std::string_view timerName(MetricTimer timer);
+
+private:
+    std::array<std::atomic<std::uint64_t>, COUNTERS> counters{};
+    std::array<LatencyHistogram, TIMERS> timers;
+};
+
+class ScopedLatency {
+public:
+    explicit ScopedLatency(MetricTimer timer);
+    ~ScopedLatency();
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    MetricTimer timer;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Rewrites a file with the current metrics every interval from a background
+// thread, replacing it atomically so scrapers never read a partial dump.
+class MetricsDumper {
+public:
+    MetricsDumper(const std::string& path, std::chrono::seconds interval, MetricsFormat format);
+    ~MetricsDumper();
+    MetricsDumper(const MetricsDumper&) = delete;
+    MetricsDumper& operator=(const MetricsDumper&) = delete;
+
+    void dumpNow();
+    const std::string& getPath() const { return path; }
+
+private:
+    std::string path;
+    std::chrono::seconds interval;
+    MetricsFormat format;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping{false};
+    std::thread worker;
+
+    void run();
+};
+
+Metrics& metrics();
+
+#endif
@@ -3,26 +3,21 @@
 Player::Player(GameField* targetField, ShipManager* enemyShips, AbilityManager* abilities)
     : targetField(targetField), enemyShips(enemyShips), abilities(abilities) {}
 
-bool Player::attack(int x, int y) {
+AttackResult Player::attack(int x, int y) {
     if (!targetField || !enemyShips) {
-        return false;
-    }
-    try {
-        targetField->attackCell(x, y, *enemyShips);
-        return true;
-    } catch (const OutOfFieldException&) {
-        return false;
+        return {AttackOutcome::OutOfBounds, -1};
     }
+    return targetField->tryAttack(x, y);
 }
 
-bool Player::useAbility() {
+AbilityResult Player::useAbility(const AbilityRequest& request) {
     if (!abilities || !abilities->hasAbilities()) {
-        return false;
+        return AbilityResult{request.type};
     }
     try {
-        return abilities->useAbility(*targetField, *enemyShips);
+        return abilities->useAbility(request, *targetField, *enemyShips);
     } catch (const NoAbilityException&) {
-        return false;
+        return AbilityResult{request.type};
     }
 }
 
@@ -30,7 +25,7 @@ bool Player::hasAbilities() const {
     return abilities && abilities->hasAbilities();
 }
 
-std::string Player::getCurrentAbilityName() const {
+std::string_view Player::getCurrentAbilityName() const {
     if (!abilities) {
         return "";
     }
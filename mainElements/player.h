@@ -14,10 +14,10 @@ protected:
 public:
     Player(GameField* targetField, ShipManager* enemyShips, AbilityManager* abilities = nullptr);
     virtual ~Player() = default;
-    virtual bool attack(int x, int y);
-    bool useAbility();
+    virtual AttackResult attack(int x, int y);
+    AbilityResult useAbility(const AbilityRequest& request);
     bool hasAbilities() const;
-    std::string getCurrentAbilityName() const;
+    std::string_view getCurrentAbilityName() const;
 };
 
 #endif
\ No newline at end of file
@@ -3,11 +3,11 @@
 #include <stdexcept>
 
 Ship::Ship(int length, Orientation orientation) 
-    : length(length), orientation(orientation), validation_flag(false) 
+    : length(length), orientation(orientation), segmentDamage(0), segmentsLeft(0), validation_flag(false) 
 {
-    if (length >= 1 && length <= 4) {
+    if (length >= 1 && length <= MAX_LENGTH) {
         validation_flag = true;
-        segmentDamage.resize(length, 0); 
+        segmentsLeft = static_cast<std::uint8_t>(length);
     }
 }
 
@@ -34,17 +34,10 @@ SegmentState Ship::getSegmentState(int index) const {
     if (index < 0 || index >= length) {
         throw std::out_of_range("Segment index out of range.");
     }
-    int damage = segmentDamage[index];
-    if (damage == 0) {
-        return SegmentState::Intact;
-    } else if (damage == 1) {
-        return SegmentState::Damaged;
-    } else {
-        return SegmentState::Destroyed;
-    }
+    return static_cast<SegmentState>((segmentDamage >> (index * 2)) & 3u);
 }
 
-void Ship::applyDamage(int index, int damage) {
+bool Ship::applyDamage(int index, int damage) {
     if (!validation_flag) {
         throw std::logic_error("Invalid Ship object.");
     }
@@ -54,22 +47,14 @@ void Ship::applyDamage(int index, int damage) {
     if (damage < 0) {
         throw std::invalid_argument("Damage cannot be negative.");
     }
-    segmentDamage[index] += damage;
-    if (segmentDamage[index] > 2) {
-        segmentDamage[index] = 2; 
-    }
-}
-
-bool Ship::isDestroyed() const {
-    if (!validation_flag) {
-        return false; 
-    }
-    for (const auto& dmg : segmentDamage) {
-        if (dmg < 2) {
-            return false; 
-        }
+    int shift = index * 2;
+    int current = (segmentDamage >> shift) & 3;
+    if (current >= 2 || damage == 0) {
+        return false;
     }
-    return true;
+    int next = damage >= 2 - current ? 2 : current + damage;
+    segmentDamage = static_cast<std::uint8_t>((segmentDamage & ~(3u << shift)) | (next << shift));
+    return next == 2 && --segmentsLeft == 0;
 }
 
 std::string Ship::getStatus() const {
@@ -1,36 +1,44 @@
 #ifndef SHIP_H
 #define SHIP_H
 
-#include <vector>
+#include <cstdint>
 #include <string>
 
-enum class SegmentState {
+enum class SegmentState : std::uint8_t {
     Intact,
     Damaged,
     Destroyed
 };
 
-enum class Orientation {
+enum class Orientation : std::uint8_t {
     Horizontal,
     Vertical
 };
 
+// Segment damage is packed two bits per segment into one byte, so a ship
+// is a small trivially copyable record. ShipManager keeps its fleet as
+// byte columns and hands out Ship records built from them.
 class Ship {
 public:
+    static const int MAX_LENGTH = 4;
+
     Ship(int length, Orientation orientation);
     bool isValid() const; 
     int getLength() const;
     Orientation getOrientation() const;
     void setOrientation(Orientation newOrientation); 
     SegmentState getSegmentState(int index) const;
-    void applyDamage(int index, int damage);
-    bool isDestroyed() const;
+    bool applyDamage(int index, int damage);
+    bool isDestroyed() const { return validation_flag && segmentsLeft == 0; }
     std::string getStatus() const;
 
 private:
+    friend class ShipManager;
+
     int length;
     Orientation orientation;
-    std::vector<int> segmentDamage; 
+    std::uint8_t segmentDamage;
+    std::uint8_t segmentsLeft;
     bool validation_flag; 
 };
 
@@ -1,15 +1,24 @@
 #include "shipmanager.h"
 #include <sstream>
 #include <cstddef>
+#include <algorithm>
+#include <stdexcept>
 
 ShipManager::ShipManager(const std::vector<int>& shipSizes) : validation_flag(true) {
+    reset(shipSizes);
+}
+
+void ShipManager::reset(const std::vector<int>& shipSizes) {
+    clearShips();
+    validation_flag = true;
+    reserveShips(shipSizes.size());
     for (int size : shipSizes) {
         Ship ship(size, Orientation::Horizontal);
         if (!ship.isValid()) {
             validation_flag = false;
             break;
         }
-        ships.push_back(ship);
+        addShip(ship);
     }
 }
 
@@ -17,44 +26,122 @@ bool ShipManager::isValid() const {
     return validation_flag;
 }
 
-const std::vector<Ship>& ShipManager::getShips() const {
-    return ships;
-}
-
-std::vector<Ship>& ShipManager::getShips() {
-    return ships;
-}
-
-Ship& ShipManager::getShip(std::size_t index) {
+void ShipManager::checkIndex(std::size_t index) const {
     if (!validation_flag) {
         throw std::logic_error("Invalid ShipManager object.");
     }
-    if (index >= ships.size()) {
+    if (index >= count) {
         throw std::out_of_range("Ship index out of range.");
     }
-    return ships[index];
 }
 
-void ShipManager::applyDamageToShip(Ship& ship, std::size_t segmentIndex, int damage) {
-    if (!validation_flag) {
-        throw std::logic_error("Invalid ShipManager object.");
+void ShipManager::reserveShips(std::size_t ships) {
+    if (ships <= capacity) {
+        return;
     }
-    if (!ship.isValid()) {
-        throw std::logic_error("Invalid Ship object.");
+    std::vector<std::uint32_t> grown(ships * 3);
+    for (int which = 0; which < BYTE_COLUMNS; ++which) {
+        const std::uint8_t* from = column(static_cast<Column>(which));
+        std::copy(from, from + count, reinterpret_cast<std::uint8_t*>(grown.data()) + which * ships);
     }
-    ship.applyDamage(static_cast<int>(segmentIndex), damage);
+    std::copy(aliveIndex(), aliveIndex() + aliveCount, grown.begin() + ships);
+    std::copy(alivePosition(), alivePosition() + count, grown.begin() + 2 * ships);
+    block.swap(grown);
+    capacity = ships;
 }
 
-bool ShipManager::allShipsDestroyed() const {
-    if (!validation_flag) {
-        return false; 
+Ship ShipManager::getShip(std::size_t index) const {
+    checkIndex(index);
+    Ship ship(column(LENGTH)[index], static_cast<Orientation>(column(ORIENTATION)[index]));
+    ship.segmentDamage = column(DAMAGE)[index];
+    ship.segmentsLeft = column(SEGMENTS_LEFT)[index];
+    return ship;
+}
+
+void ShipManager::storeShip(std::size_t index, const Ship& ship) {
+    column(LENGTH)[index] = static_cast<std::uint8_t>(ship.length);
+    column(ORIENTATION)[index] = static_cast<std::uint8_t>(ship.orientation);
+    column(DAMAGE)[index] = ship.segmentDamage;
+    column(SEGMENTS_LEFT)[index] = ship.segmentsLeft;
+}
+
+int ShipManager::getLength(std::size_t index) const {
+    checkIndex(index);
+    return column(LENGTH)[index];
+}
+
+Orientation ShipManager::getOrientation(std::size_t index) const {
+    checkIndex(index);
+    return static_cast<Orientation>(column(ORIENTATION)[index]);
+}
+
+void ShipManager::setOrientation(std::size_t index, Orientation orientation) {
+    checkIndex(index);
+    column(ORIENTATION)[index] = static_cast<std::uint8_t>(orientation);
+}
+
+SegmentState ShipManager::getSegmentState(std::size_t index, int segmentIndex) const {
+    return getShip(index).getSegmentState(segmentIndex);
+}
+
+int ShipManager::getSegmentsLeft(std::size_t index) const {
+    checkIndex(index);
+    return column(SEGMENTS_LEFT)[index];
+}
+
+std::size_t ShipManager::getAliveShip(std::size_t rank) const {
+    if (rank >= aliveCount) {
+        throw std::out_of_range("Alive ship rank out of range.");
     }
-    for (const auto& ship : ships) {
-        if (!ship.isDestroyed()) {
-            return false;
+    return aliveIndex()[rank];
+}
+
+int ShipManager::getLiveSegment(std::size_t index, int rank) const {
+    checkIndex(index);
+    unsigned damage = column(DAMAGE)[index];
+    int length = column(LENGTH)[index];
+    for (int segment = 0; segment < length; ++segment) {
+        if (((damage >> (segment * 2)) & 3u) < 2 && rank-- == 0) {
+            return segment;
         }
     }
-    return true;
+    throw std::out_of_range("Live segment rank out of range.");
+}
+
+bool ShipManager::isDestroyed(std::size_t index) const {
+    checkIndex(index);
+    return column(SEGMENTS_LEFT)[index] == 0;
+}
+
+void ShipManager::clearShips() {
+    count = 0;
+    aliveCount = 0;
+}
+
+void ShipManager::addShip(const Ship& ship) {
+    if (count == capacity) {
+        reserveShips(std::max<std::size_t>(8, capacity * 2));
+    }
+    storeShip(count, ship);
+    if (!ship.isDestroyed()) {
+        alivePosition()[count] = static_cast<std::uint32_t>(aliveCount);
+        aliveIndex()[aliveCount++] = static_cast<std::uint32_t>(count);
+    }
+    ++count;
+}
+
+bool ShipManager::applyDamage(std::size_t index, int segmentIndex, int damage) {
+    Ship ship = getShip(index);
+    bool sunk = ship.applyDamage(segmentIndex, damage);
+    column(DAMAGE)[index] = ship.segmentDamage;
+    column(SEGMENTS_LEFT)[index] = ship.segmentsLeft;
+    if (sunk) {
+        std::uint32_t slot = alivePosition()[index];
+        std::uint32_t last = aliveIndex()[--aliveCount];
+        aliveIndex()[slot] = last;
+        alivePosition()[last] = slot;
+    }
+    return sunk;
 }
 
 std::string ShipManager::getShipsStatus() const {
@@ -63,8 +150,8 @@ std::string ShipManager::getShipsStatus() const {
     }
     std::ostringstream status;
     status << "Ships status:\n";
-    for (std::size_t i = 0; i < ships.size(); ++i) {
-        status << "Ship " << i + 1 << ": " << ships[i].getStatus() << "\n";
+    for (std::size_t i = 0; i < count; ++i) {
+        status << "Ship " << i + 1 << ": " << getShip(i).getStatus() << "\n";
     }
     return status.str();
 }
@@ -4,23 +4,65 @@
 #include <vector>
 #include <string>
 #include <cstddef>
+#include <cstdint>
 #include "ship.h"
 
+// The fleet is one contiguous struct-of-arrays block: byte columns for the
+// ship lengths, orientations, packed segment damage and remaining segment
+// counts, followed by two index columns. An attack reads and writes only
+// the damage and segments-left columns, and copying a fleet copies one
+// block. Ships are addressed by index and getShip returns a Ship record
+// assembled from the columns as a snapshot; all changes go through the
+// manager. Unsunk ships are also kept in a dense index column that
+// applyDamage swap-removes from, so a random live target is picked by rank
+// without scanning the fleet, and a second column holds each ship's
+// position in it. reserveShips sizes all columns together.
 class ShipManager {
 public:
     ShipManager(const std::vector<int>& shipSizes);
+    void reset(const std::vector<int>& shipSizes);
 
     bool isValid() const;
-    const std::vector<Ship>& getShips() const;
-    std::vector<Ship>& getShips();
-    Ship& getShip(std::size_t index); 
-    void applyDamageToShip(Ship& ship, std::size_t segmentIndex, int damage);
-    bool allShipsDestroyed() const;
+    std::size_t getShipCount() const { return count; }
+    Ship getShip(std::size_t index) const;
+    int getLength(std::size_t index) const;
+    Orientation getOrientation(std::size_t index) const;
+    void setOrientation(std::size_t index, Orientation orientation);
+    SegmentState getSegmentState(std::size_t index, int segmentIndex) const;
+    bool isDestroyed(std::size_t index) const;
+    void clearShips();
+    void addShip(const Ship& ship);
+    bool applyDamage(std::size_t index, int segmentIndex, int damage);
+    bool allShipsDestroyed() const { return validation_flag && aliveCount == 0; }
+    std::size_t getAliveCount() const { return aliveCount; }
+    std::size_t getAliveShip(std::size_t rank) const;
+    int getSegmentsLeft(std::size_t index) const;
+    int getLiveSegment(std::size_t index, int rank) const;
     std::string getShipsStatus() const; 
 
 private:
-    std::vector<Ship> ships;
+    enum Column { LENGTH, ORIENTATION, DAMAGE, SEGMENTS_LEFT, BYTE_COLUMNS };
+
+    std::vector<std::uint32_t> block;
+    std::size_t count{0};
+    std::size_t capacity{0};
+    std::size_t aliveCount{0};
     bool validation_flag;
+
+    // The byte columns share the first capacity words of the block.
+    std::uint8_t* column(Column which) {
+        return reinterpret_cast<std::uint8_t*>(block.data()) + which * capacity;
+    }
+    const std::uint8_t* column(Column which) const {
+        return reinterpret_cast<const std::uint8_t*>(block.data()) + which * capacity;
+    }
+    std::uint32_t* aliveIndex() { return block.data() + capacity; }
+    const std::uint32_t* aliveIndex() const { return block.data() + capacity; }
+    std::uint32_t* alivePosition() { return block.data() + 2 * capacity; }
+
+    void checkIndex(std::size_t index) const;
+    void reserveShips(std::size_t ships);
+    void storeShip(std::size_t index, const Ship& ship);
 };
 
-#endif
\ No newline at end of file
+#endif
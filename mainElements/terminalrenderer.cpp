@@ -0,0 +1,262 @@
+#include "terminalrenderer.h"
+#include <algorithm>
+#include <iostream>
+#ifndef _WIN32
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const std::size_t OUTPUT_LINES = 4;
+const std::string FIELD_GAP = "    ";
+const std::string LIVE_LEGEND = "Legend: . unknown  O miss  S your ship  X hit  # destroyed";
+
+struct Viewport {
+    int startX;
+    int startY;
+    int endX;
+    int endY;
+    int cellWidth;
+};
+
+Viewport viewportOf(const Game& game) {
+    Viewport view;
+    view.startX = game.getViewportX();
+    view.startY = game.getViewportY();
+    view.endX = std::min(game.getFieldWidth(), view.startX + Game::VIEWPORT_SIZE);
+    view.endY = std::min(game.getFieldHeight(), view.startY + Game::VIEWPORT_SIZE);
+    view.cellWidth = std::max(static_cast<int>(std::to_string(std::max(view.endX, view.endY) - 1).size()) + 1, 2);
+    return view;
+}
+
+void appendCell(std::string& out, const std::string& text, int width) {
+    if (static_cast<int>(text.size()) < width) {
+        out.append(width - text.size(), ' ');
+    }
+    out += text;
+}
+
+void appendCell(std::string& out, char symbol, int width) {
+    out.append(width - 1, ' ');
+    out += symbol;
+}
+
+char cellSymbol(const GameField& field, int x, int y, bool revealShips) {
+    SegmentState segment;
+    if (field.trySegmentState(x, y, segment)) {
+        switch (segment) {
+            case SegmentState::Intact: return revealShips ? 'S' : '.';
+            case SegmentState::Damaged: return 'X';
+            case SegmentState::Destroyed: return '#';
+        }
+    }
+    return field.getBoard().test(BoardPlane::Miss, x, y) ? 'O' : '.';
+}
+
+std::vector<std::string> gridLines(const Game& game, bool isPlayerField) {
+    Viewport view = viewportOf(game);
+    const GameField* field = isPlayerField ? game.getPlayerField() : game.getComputerField();
+    std::vector<std::string> lines;
+    std::string line;
+    appendCell(line, "", view.cellWidth);
+    for (int x = view.startX; x < view.endX; ++x) {
+        appendCell(line, std::to_string(x), view.cellWidth);
+    }
+    lines.push_back(line);
+    for (int y = view.startY; y < view.endY; ++y) {
+        line.clear();
+        appendCell(line, std::to_string(y), view.cellWidth);
+        for (int x = view.startX; x < view.endX; ++x) {
+            appendCell(line, field ? cellSymbol(*field, x, y, isPlayerField) : '.', view.cellWidth);
+        }
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::string viewportNote(const Game& game) {
+    Viewport view = viewportOf(game);
+    if (view.endX - view.startX >= game.getFieldWidth() && view.endY - view.startY >= game.getFieldHeight()) {
+        return "";
+    }
+    return "Showing columns " + std::to_string(view.startX) + "-" + std::to_string(view.endX - 1) +
+           ", rows " + std::to_string(view.startY) + "-" + std::to_string(view.endY - 1) +
+           " of " + std::to_string(game.getFieldWidth()) + "x" + std::to_string(game.getFieldHeight());
+}
+
+void appendNumber(std::string& out, std::size_t value) {
+    out += std::to_string(value);
+}
+
+bool terminalSize(int& rows, int& columns) {
+#ifndef _WIN32
+    winsize size{};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0) {
+        rows = size.ws_row;
+        columns = size.ws_col;
+        return true;
+    }
+#endif
+    return false;
+}
+
+}
+
+TerminalRenderer::TerminalRenderer(std::ostream& os)
+    : os(os), terminal(false), live(false), screenRows(0) {
+#ifndef _WIN32
+    terminal = &os == &std::cout && isatty(STDIN_FILENO) && isatty(STDOUT_FILENO);
+#endif
+}
+
+TerminalRenderer::~TerminalRenderer() {
+    release();
+}
+
+void TerminalRenderer::appendField(std::string& out, const Game& game, bool isPlayerField) {
+    for (const std::string& line : gridLines(game, isPlayerField)) {
+        out += line;
+        out += '\n';
+    }
+    std::string note = viewportNote(game);
+    if (!note.empty()) {
+        out += note;
+        out += '\n';
+    }
+}
+
+void TerminalRenderer::appendLegend(std::string& out) {
+    out += "\nLegend:\n"
+           "  .  - Unknown cell\n"
+           "  O  - Miss\n"
+           "  S  - Your ship (only on your field)\n"
+           "  X  - Hit\n"
+           "  #  - Destroyed segment\n";
+}
+
+void TerminalRenderer::render(const Game& game, bool fullRedraw) {
+    int rows = 0;
+    int columns = 0;
+    std::vector<std::string> next;
+    if (terminal && terminalSize(rows, columns)) {
+        next = buildFrame(game);
+    }
+    bool fits = !next.empty() && next.size() + OUTPUT_LINES <= static_cast<std::size_t>(rows) &&
+                next[0].size() <= static_cast<std::size_t>(columns);
+    if (!fits) {
+        release();
+        buffer.clear();
+        buffer += "Your Field:\n";
+        appendField(buffer, game, true);
+        buffer += "\nEnemy Field:\n";
+        appendField(buffer, game, false);
+        appendLegend(buffer);
+        os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        os.flush();
+        return;
+    }
+
+    bool sameShape = live && rows == screenRows && next.size() == frame.size();
+    for (std::size_t i = 0; sameShape && i < next.size(); ++i) {
+        sameShape = next[i].size() == frame[i].size();
+    }
+    if (fullRedraw || !sameShape) {
+        drawFull(next, rows);
+    } else {
+        drawChanges(next);
+    }
+    frame = std::move(next);
+}
+
+void TerminalRenderer::release() {
+    if (!live) {
+        return;
+    }
+    buffer = "\x1b[r\x1b[";
+    appendNumber(buffer, static_cast<std::size_t>(screenRows));
+    buffer += ";1H\n";
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    os.flush();
+    live = false;
+    frame.clear();
+}
+
+std::vector<std::string> TerminalRenderer::buildFrame(const Game& game) const {
+    std::vector<std::string> player = gridLines(game, true);
+    std::vector<std::string> enemy = gridLines(game, false);
+    std::size_t gridWidth = player[0].size();
+
+    std::vector<std::string> lines;
+    std::string title = "Your Field:";
+    title.resize(gridWidth + FIELD_GAP.size(), ' ');
+    lines.push_back(title + "Enemy Field:");
+    for (std::size_t i = 0; i < player.size(); ++i) {
+        lines.push_back(player[i] + FIELD_GAP + enemy[i]);
+    }
+    lines.push_back(viewportNote(game));
+    lines.push_back(LIVE_LEGEND);
+
+    std::size_t width = 0;
+    for (const std::string& line : lines) {
+        width = std::max(width, line.size());
+    }
+    for (std::string& line : lines) {
+        line.resize(width, ' ');
+    }
+    return lines;
+}
+
+void TerminalRenderer::drawFull(const std::vector<std::string>& next, int rows) {
+    buffer = "\x1b[r\x1b[H\x1b[2J";
+    for (const std::string& line : next) {
+        buffer += line;
+        buffer += '\n';
+    }
+    std::size_t top = next.size() + 2;
+    buffer += "\x1b[";
+    appendNumber(buffer, top);
+    buffer += ';';
+    appendNumber(buffer, static_cast<std::size_t>(rows));
+    buffer += "r\x1b[";
+    appendNumber(buffer, top);
+    buffer += ";1H";
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    os.flush();
+    live = true;
+    screenRows = rows;
+}
+
+void TerminalRenderer::drawChanges(const std::vector<std::string>& next) {
+    buffer = "\x1b" "7";
+    bool changed = false;
+    for (std::size_t row = 0; row < next.size(); ++row) {
+        const std::string& before = frame[row];
+        const std::string& after = next[row];
+        std::size_t column = 0;
+        while (column < after.size()) {
+            if (before[column] == after[column]) {
+                ++column;
+                continue;
+            }
+            std::size_t end = column;
+            while (end < after.size() && before[end] != after[end]) {
+                ++end;
+            }
+            buffer += "\x1b[";
+            appendNumber(buffer, row + 1);
+            buffer += ';';
+            appendNumber(buffer, column + 1);
+            buffer += 'H';
+            buffer.append(after, column, end - column);
+            changed = true;
+            column = end;
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    buffer += "\x1b" "8";
+    os.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    os.flush();
+}
@@ -0,0 +1,42 @@
+#ifndef TERMINAL_RENDERER_H
+#define TERMINAL_RENDERER_H
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "game.h"
+
+// Draws both fields into one buffer and writes it with a single call. On
+// an interactive terminal the fields sit side by side at the top of the
+// screen, below them a scroll region keeps command output from moving
+// them, and later frames only rewrite the cells that changed, using ANSI
+// cursor positioning. When the output is not a terminal, or the frame does
+// not fit the screen, the fields are printed one after the other as text.
+class TerminalRenderer {
+public:
+    explicit TerminalRenderer(std::ostream& os);
+    ~TerminalRenderer();
+    TerminalRenderer(const TerminalRenderer&) = delete;
+    TerminalRenderer& operator=(const TerminalRenderer&) = delete;
+
+    void render(const Game& game, bool fullRedraw);
+    void release();
+    bool isLive() const { return live; }
+
+    static void appendField(std::string& out, const Game& game, bool isPlayerField);
+    static void appendLegend(std::string& out);
+
+private:
+    std::ostream& os;
+    bool terminal;
+    bool live;
+    int screenRows;
+    std::vector<std::string> frame;
+    std::string buffer;
+
+    std::vector<std::string> buildFrame(const Game& game) const;
+    void drawFull(const std::vector<std::string>& next, int rows);
+    void drawChanges(const std::vector<std::string>& next);
+};
+
+#endif
@@ -0,0 +1,275 @@
+#include "gameserver.h"
+#include "../mainElements/metrics.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+const int MAX_EVENTS = 256;
+const char REPLY_END[] = ".\n";
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+}
+
+GameServer::GameServer(const ServerOptions& options)
+    : options(options), seeds(options.seed) {
+    if (!options.eventLog.empty()) {
+        eventLogFile.open(options.eventLog, std::ios::app);
+        if (!eventLogFile) {
+            throw std::runtime_error("Failed to open event log " + options.eventLog);
+        }
+        eventLog = std::make_unique<AsyncEventSink>(eventLogFile);
+    }
+    sockaddr_un address{};
+    if (options.socketPath.empty() || options.socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Invalid socket path " + options.socketPath);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw systemError("socket");
+    }
+    unlink(options.socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(listenFd);
+        throw systemError("bind " + options.socketPath);
+    }
+    if (listen(listenFd, SOMAXCONN) < 0) {
+        close(listenFd);
+        throw systemError("listen");
+    }
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigprocmask(SIG_BLOCK, &signals, nullptr);
+    signalFd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (signalFd < 0 || epollFd < 0) {
+        int error = errno;
+        close(listenFd);
+        if (signalFd >= 0) {
+            close(signalFd);
+        }
+        errno = error;
+        throw systemError("epoll setup");
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    bool added = epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) == 0;
+    event.data.fd = signalFd;
+    added = added && epoll_ctl(epollFd, EPOLL_CTL_ADD, signalFd, &event) == 0;
+    if (!added) {
+        int error = errno;
+        close(epollFd);
+        close(signalFd);
+        close(listenFd);
+        errno = error;
+        throw systemError("epoll_ctl");
+    }
+}
+
+GameServer::~GameServer() {
+    for (auto& entry : connections) {
+        close(entry.first);
+    }
+    close(epollFd);
+    close(signalFd);
+    close(listenFd);
+    unlink(options.socketPath.c_str());
+}
+
+void GameServer::run() {
+    epoll_event events[MAX_EVENTS];
+    while (true) {
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("epoll_wait");
+        }
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == signalFd) {
+                return;
+            }
+            if (fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& connection = it->second;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeClient(fd);
+                continue;
+            }
+            if ((events[i].events & EPOLLIN) && !connection.closing) {
+                readClient(connection);
+            }
+            if (!flushClient(connection) || (connection.closing && connection.sent == connection.output.size())) {
+                closeClient(fd);
+            }
+        }
+    }
+}
+
+void GameServer::acceptClients() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;
+        }
+        if (connections.size() >= options.maxSessions) {
+            rejectClient(fd);
+            continue;
+        }
+
+        Connection& connection = connections[fd];
+        connection.fd = fd;
+        connection.interest = EPOLLIN | EPOLLRDHUP;
+        epoll_event event{};
+        event.events = connection.interest;
+        event.data.fd = fd;
+        try {
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+                throw systemError("epoll_ctl");
+            }
+            connection.session = std::make_unique<GameSession>(
+                options.width, options.height, seeds(), options.saveDirectory, eventLog.get());
+            connection.session->greet(connection.output);
+        } catch (const std::exception& e) {
+            connection.output += "Error: ";
+            connection.output += e.what();
+            connection.output += "\n";
+            connection.closing = true;
+        }
+        connection.output += REPLY_END;
+        if (!flushClient(connection) || connection.closing) {
+            closeClient(fd);
+        }
+    }
+}
+
+void GameServer::rejectClient(int fd) {
+    static const char message[] = "Error: server is full\n.\n";
+    send(fd, message, sizeof(message) - 1, MSG_NOSIGNAL | MSG_DONTWAIT);
+    close(fd);
+}
+
+void GameServer::readClient(Connection& connection) {
+    char buffer[4096];
+    while (!connection.closing && !connection.outputFull()) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, static_cast<std::size_t>(received));
+            runCommands(connection);
+            continue;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            connection.closing = true;
+        }
+        break;
+    }
+}
+
+void GameServer::runCommands(Connection& connection) {
+    std::size_t start = 0;
+    std::size_t end;
+    while (!connection.session->isFinished() && !connection.outputFull() &&
+           (end = connection.input.find('\n', start)) != std::string::npos) {
+        std::string line = connection.input.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        start = end + 1;
+        {
+            ScopedLatency latency(MetricTimer::ServerCommand);
+            connection.session->execute(line, connection.output);
+        }
+        connection.output += REPLY_END;
+    }
+    connection.input.erase(0, start);
+    if (connection.session->isFinished()) {
+        connection.closing = true;
+    } else if (connection.input.size() > MAX_LINE && connection.input.find('\n') == std::string::npos) {
+        connection.output += "Error: command line too long\n";
+        connection.output += REPLY_END;
+        connection.closing = true;
+    }
+}
+
+bool GameServer::flushClient(Connection& connection) {
+    while (connection.sent < connection.output.size()) {
+        ssize_t written = send(connection.fd, connection.output.data() + connection.sent,
+                               connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (written > 0) {
+            connection.sent += static_cast<std::size_t>(written);
+            if (connection.sent == connection.output.size()) {
+                connection.output.clear();
+                connection.sent = 0;
+                if (!connection.closing && connection.input.find('\n') != std::string::npos) {
+                    runCommands(connection);
+                }
+            }
+            continue;
+        }
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return updateInterest(connection);
+        }
+        return false;
+    }
+    return updateInterest(connection);
+}
+
+bool GameServer::updateInterest(Connection& connection) {
+    std::uint32_t interest = connection.closing || connection.outputFull()
+        ? 0u : static_cast<std::uint32_t>(EPOLLIN | EPOLLRDHUP);
+    if (connection.sent < connection.output.size()) {
+        interest |= EPOLLOUT;
+    }
+    if (interest == connection.interest) {
+        return true;
+    }
+    epoll_event event{};
+    event.events = interest;
+    event.data.fd = connection.fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event) < 0) {
+        return false;
+    }
+    connection.interest = interest;
+    return true;
+}
+
+void GameServer::closeClient(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+}
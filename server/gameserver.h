@@ -0,0 +1,76 @@
+#ifndef GAME_SERVER_H
+#define GAME_SERVER_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "gamesession.h"
+
+struct ServerOptions {
+    std::string socketPath;
+    int width{10};
+    int height{10};
+    std::uint64_t seed{GameRng::randomSeed()};
+    std::size_t maxSessions{10000};
+    std::string saveDirectory{"."};
+    std::string eventLog;
+};
+
+// Serves one GameSession per connection on a Unix-domain stream socket from
+// a single epoll loop. The protocol is line based: the client sends one
+// command per line and every reply, including the greeting, ends with a
+// line holding a single '.'. Sockets are non-blocking and replies are
+// queued per session, so a slow reader never stalls the others. Once a
+// session has MAX_OUTPUT bytes of replies unsent the server stops reading
+// and running its commands until the client catches up, and a line longer
+// than MAX_LINE closes the session, so neither buffer grows without bound.
+// With an event log every session's events are also written to that file
+// by an AsyncEventSink; the loop is the only thread that emits, so the
+// single-producer ring holds. run() returns after SIGINT or SIGTERM.
+class GameServer {
+public:
+    static const std::size_t MAX_LINE = 4096;
+    static const std::size_t MAX_OUTPUT = 1 << 20;
+
+    explicit GameServer(const ServerOptions& options);
+    ~GameServer();
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    void run();
+    std::size_t getSessionCount() const { return connections.size(); }
+
+private:
+    struct Connection {
+        int fd;
+        std::unique_ptr<GameSession> session;
+        std::string input;
+        std::string output;
+        std::size_t sent{0};
+        std::uint32_t interest{0};
+        bool closing{false};
+
+        bool outputFull() const { return output.size() - sent >= MAX_OUTPUT; }
+    };
+
+    ServerOptions options;
+    GameRng seeds;
+    int listenFd{-1};
+    int epollFd{-1};
+    int signalFd{-1};
+    std::ofstream eventLogFile;
+    std::unique_ptr<AsyncEventSink> eventLog;
+    std::unordered_map<int, Connection> connections;
+
+    void acceptClients();
+    void rejectClient(int fd);
+    void readClient(Connection& connection);
+    void runCommands(Connection& connection);
+    bool flushClient(Connection& connection);
+    bool updateInterest(Connection& connection);
+    void closeClient(int fd);
+};
+
+#endif
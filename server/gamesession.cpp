@@ -0,0 +1,238 @@
+#include "gamesession.h"
+#include "../mainElements/gamestate.h"
+#include "../mainElements/metrics.h"
+#include "../mainElements/terminalrenderer.h"
+#include <filesystem>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const std::size_t MAX_SAVE_NAME = 64;
+
+bool isValidSaveName(const std::string& name) {
+    if (name.empty() || name.size() > MAX_SAVE_NAME) {
+        return false;
+    }
+    for (char c : name) {
+        bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                       (c >= '0' && c <= '9') || c == '_' || c == '-';
+        if (!allowed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void appendHelp(std::string& out) {
+    out += "Available commands:\n"
+           "  attack x y   - Attack position (x,y)\n"
+           "  ability      - Use current ability (ability x y for Scanner)\n"
+           "  status       - Show round and available ability\n"
+           "  display      - Show game fields\n"
+           "  view x y     - Show the fields starting at (x,y)\n"
+           "  save name    - Save game\n"
+           "  load name    - Load game\n"
+           "  export name  - Export game as readable text\n"
+           "  saves        - List saved games\n"
+           "  stats        - Show server counters and latencies (stats json, stats prometheus)\n"
+           "  new          - Start a new game\n"
+           "  help         - Show this help\n"
+           "  quit         - Close the session\n";
+}
+
+}
+
+void SessionEventSink::emit(const GameEvent& event) {
+    if (target) {
+        formatEvent(*target, event);
+    }
+    if (log) {
+        log->emit(event);
+    }
+}
+
+GameSession::GameSession(int width, int height, std::uint64_t seed, const std::string& saveDirectory,
+                         EventSink* log)
+    : game(width, height, Game::defaultShipSizes(), seed), saveDirectory(saveDirectory) {
+    sink.setLog(log);
+    game.setEventSink(sink);
+    game.setAutoPlacement(true);
+}
+
+void GameSession::greet(std::string& out) {
+    out += "Welcome to Battleship!\n";
+    out += "Game seed: " + std::to_string(game.getSeed()) + "\n";
+    start(out);
+    out += "Type 'help' for available commands.\n";
+}
+
+void GameSession::start(std::string& out) {
+    sink.setTarget(&out);
+    game.startNewGame();
+    sink.setTarget(nullptr);
+    out += "Your ships have been placed.\n";
+    appendStatus(out);
+}
+
+void GameSession::execute(const std::string& line, std::string& out) {
+    std::istringstream args(line);
+    std::string command;
+    args >> command;
+    sink.setTarget(&out);
+    try {
+        if (command.empty()) {
+        } else if (command == "help") {
+            appendHelp(out);
+        } else if (command == "attack") {
+            attack(args, out);
+        } else if (command == "ability") {
+            useAbility(args, out);
+        } else if (command == "status") {
+            appendStatus(out);
+        } else if (command == "display") {
+            appendFields(out);
+            TerminalRenderer::appendLegend(out);
+        } else if (command == "view") {
+            int x, y;
+            if (!(args >> x >> y)) {
+                out += "Invalid view format. Use: view x y\n";
+            } else {
+                game.setViewport(x, y);
+                appendFields(out);
+            }
+        } else if (command == "save" || command == "export") {
+            bool save = command == "save";
+            std::string path;
+            if (savePath(args, save ? ".sav" : ".txt", path, out)) {
+                if (save) {
+                    GameState::saveGame(game, path);
+                    out += "Game saved successfully.\n";
+                } else {
+                    GameState::exportText(game, path);
+                    out += "Game exported successfully.\n";
+                }
+            }
+        } else if (command == "load") {
+            std::string path;
+            if (savePath(args, ".sav", path, out)) {
+                GameState::loadGame(game, path);
+                out += "Game loaded successfully.\n";
+                appendStatus(out);
+            }
+        } else if (command == "saves") {
+            out += "Available saves:\n";
+            for (const auto& entry : fs::directory_iterator(saveDirectory)) {
+                if (entry.path().extension() == ".sav" || entry.path().extension() == ".txt") {
+                    out += "  " + entry.path().filename().string() + "\n";
+                }
+            }
+        } else if (command == "stats") {
+            std::string mode;
+            args >> mode;
+            std::ostringstream text;
+            if (mode == "json") {
+                metrics().writeJson(text);
+            } else if (mode == "prometheus") {
+                metrics().writePrometheus(text);
+            } else {
+                metrics().writeText(text);
+            }
+            out += text.str();
+        } else if (command == "new") {
+            start(out);
+        } else if (command == "quit") {
+            out += "Goodbye.\n";
+            finished = true;
+        } else {
+            out += "Unknown command. Type 'help' for available commands.\n";
+        }
+    } catch (const std::exception& e) {
+        out += "Error: ";
+        out += e.what();
+        out += "\n";
+    }
+    sink.setTarget(nullptr);
+}
+
+void GameSession::appendStatus(std::string& out) const {
+    out += "Current Round: " + std::to_string(game.getCurrentRound()) + "\n";
+    if (game.hasPlayerAbility()) {
+        out += "Available ability: ";
+        out += game.getCurrentPlayerAbilityName();
+        out += "\n";
+    }
+    if (game.isGameOver()) {
+        out += "The game is over. Type 'new' to play again.\n";
+    }
+}
+
+void GameSession::appendFields(std::string& out) const {
+    out += "Your Field:\n";
+    TerminalRenderer::appendField(out, game, true);
+    out += "\nEnemy Field:\n";
+    TerminalRenderer::appendField(out, game, false);
+}
+
+void GameSession::attack(std::istringstream& args, std::string& out) {
+    int x, y;
+    if (!(args >> x >> y)) {
+        out += "Invalid attack format. Use: attack x y\n";
+        return;
+    }
+    if (game.isGameOver()) {
+        out += "The game is over. Type 'new' to play again.\n";
+        return;
+    }
+    if (game.makePlayerAttack(x, y)) {
+        if (!game.isGameOver()) {
+            out += "\nComputer's turn:\n";
+            game.makeComputerMove();
+        }
+    } else {
+        out += "Invalid attack coordinates or cell already targeted.\n";
+    }
+    finishRoundIfOver(out);
+}
+
+void GameSession::useAbility(std::istringstream& args, std::string& out) {
+    if (!game.hasPlayerAbility()) {
+        out += "No ability available.\n";
+        return;
+    }
+    AbilityRequest request{game.getPlayerAbilities()->front()};
+    if (request.type == AbilityType::Scanner && !(args >> request.x >> request.y)) {
+        out += "Scanner needs a target. Use: ability x y\n";
+        return;
+    }
+    game.usePlayerAbility(request);
+    finishRoundIfOver(out);
+}
+
+void GameSession::finishRoundIfOver(std::string& out) {
+    if (game.getGameStatus() == GameStatus::PlayerWon) {
+        if (game.getCurrentRound() < MAX_ROUNDS) {
+            out += "\nCongratulations! You won round " + std::to_string(game.getCurrentRound()) + "!\n";
+            game.startNextRound();
+        } else {
+            out += "\nCongratulations! You've completed all " + std::to_string(MAX_ROUNDS) + " rounds!\n"
+                   "Type 'new' to play again.\n";
+        }
+    } else if (game.getGameStatus() == GameStatus::PlayerLost) {
+        out += "\nGame Over! You lost in round " + std::to_string(game.getCurrentRound()) + ".\n"
+               "Type 'new' to play again.\n";
+    }
+}
+
+bool GameSession::savePath(std::istringstream& args, const char* extension,
+                           std::string& path, std::string& out) const {
+    std::string name;
+    args >> name;
+    if (!isValidSaveName(name)) {
+        out += "Invalid save name. Use letters, digits, '-' and '_'.\n";
+        return false;
+    }
+    path = (fs::path(saveDirectory) / (name + extension)).string();
+    return true;
+}
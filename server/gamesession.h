@@ -0,0 +1,54 @@
+#ifndef GAME_SESSION_H
+#define GAME_SESSION_H
+
+#include <iosfwd>
+#include <string>
+#include "../mainElements/game.h"
+
+// Formats events into the reply being built and, when a log is set, also
+// hands them to that sink.
+class SessionEventSink : public EventSink {
+public:
+    void setTarget(std::string* out) { target = out; }
+    void setLog(EventSink* sink) { log = sink; }
+    void emit(const GameEvent& event) override;
+
+private:
+    std::string* target{nullptr};
+    EventSink* log{nullptr};
+};
+
+// One client's game. execute() runs a single command line with the same
+// verbs as the interactive game and appends the reply text to out, so the
+// session never touches stdin or stdout itself. Fleets are placed
+// automatically and saves live in saveDirectory. Events also go to log
+// when one is given.
+class GameSession {
+public:
+    static const int MAX_ROUNDS = 3;
+
+    GameSession(int width, int height, std::uint64_t seed, const std::string& saveDirectory,
+                EventSink* log = nullptr);
+    GameSession(const GameSession&) = delete;
+    GameSession& operator=(const GameSession&) = delete;
+
+    void greet(std::string& out);
+    void execute(const std::string& line, std::string& out);
+    bool isFinished() const { return finished; }
+
+private:
+    Game game;
+    SessionEventSink sink;
+    std::string saveDirectory;
+    bool finished{false};
+
+    void start(std::string& out);
+    void appendStatus(std::string& out) const;
+    void appendFields(std::string& out) const;
+    void attack(std::istringstream& args, std::string& out);
+    void useAbility(std::istringstream& args, std::string& out);
+    void finishRoundIfOver(std::string& out);
+    bool savePath(std::istringstream& args, const char* extension, std::string& path, std::string& out) const;
+};
+
+#endif
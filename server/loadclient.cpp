@@ -0,0 +1,194 @@
+#include "loadclient.h"
+#include "../mainElements/gamerng.h"
+#include "../mainElements/metrics.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+const char REPLY_END[] = "\n.\n";
+const int MAX_EVENTS = 256;
+
+struct LoadSession {
+    int fd{-1};
+    std::string input;
+    std::vector<int> targets;
+    std::size_t nextTarget{0};
+    int sent{0};
+    bool greeted{false};
+    bool needsNewGame{false};
+    bool quitting{false};
+    std::chrono::steady_clock::time_point sentAt;
+};
+
+std::runtime_error systemError(const std::string& what) {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+int connectTo(const std::string& path) {
+    sockaddr_un address{};
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Invalid socket path " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw systemError("socket");
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        throw systemError("connect " + path);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+void sendLine(LoadSession& session, const std::string& line) {
+    std::string text = line + "\n";
+    std::size_t offset = 0;
+    while (offset < text.size()) {
+        ssize_t written = send(session.fd, text.data() + offset, text.size() - offset, MSG_NOSIGNAL);
+        if (written > 0) {
+            offset += static_cast<std::size_t>(written);
+        } else if (written < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+            continue;
+        } else {
+            throw systemError("send");
+        }
+    }
+    session.sentAt = std::chrono::steady_clock::now();
+}
+
+void sendNextCommand(LoadSession& session, const LoadTestOptions& options) {
+    if (session.sent >= options.commands) {
+        session.quitting = true;
+        sendLine(session, "quit");
+        return;
+    }
+    ++session.sent;
+    if (session.needsNewGame || session.nextTarget == session.targets.size()) {
+        session.needsNewGame = false;
+        session.nextTarget = 0;
+        sendLine(session, "new");
+        return;
+    }
+    int cell = session.targets[session.nextTarget++];
+    sendLine(session, "attack " + std::to_string(cell % options.width) + " " +
+                      std::to_string(cell / options.width));
+}
+
+}
+
+void runLoadTest(const LoadTestOptions& options, std::ostream& os) {
+    if (options.clients <= 0 || options.commands <= 0 || options.width <= 0 || options.height <= 0) {
+        throw std::invalid_argument("Load test needs positive clients, commands and field size");
+    }
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        throw systemError("epoll_create1");
+    }
+
+    GameRng gen(options.seed);
+    int cells = options.width * options.height;
+    std::vector<LoadSession> sessions(static_cast<std::size_t>(options.clients));
+    LatencyHistogram latency;
+    int open = 0;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        for (std::size_t i = 0; i < sessions.size(); ++i) {
+            LoadSession& session = sessions[i];
+            session.targets.resize(static_cast<std::size_t>(cells));
+            for (int cell = 0; cell < cells; ++cell) {
+                std::size_t pick = static_cast<std::size_t>(gen.below(static_cast<std::uint64_t>(cell) + 1));
+                session.targets[cell] = session.targets[pick];
+                session.targets[pick] = cell;
+            }
+            session.fd = connectTo(options.socketPath);
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.u64 = i;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, session.fd, &event);
+            ++open;
+        }
+
+        epoll_event events[MAX_EVENTS];
+        char buffer[4096];
+        while (open > 0) {
+            int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+            if (ready < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ready < 0) {
+                throw systemError("epoll_wait");
+            }
+            for (int e = 0; e < ready; ++e) {
+                LoadSession& session = sessions[events[e].data.u64];
+                bool closed = false;
+                while (true) {
+                    ssize_t received = recv(session.fd, buffer, sizeof(buffer), 0);
+                    if (received > 0) {
+                        session.input.append(buffer, static_cast<std::size_t>(received));
+                        continue;
+                    }
+                    if (received < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    closed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+                    break;
+                }
+
+                std::size_t end;
+                while (!session.quitting && (end = session.input.find(REPLY_END)) != std::string::npos) {
+                    if (session.greeted) {
+                        latency.record(static_cast<std::uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - session.sentAt).count()));
+                    }
+                    session.greeted = true;
+                    std::string reply = session.input.substr(0, end);
+                    session.input.erase(0, end + sizeof(REPLY_END) - 1);
+                    session.needsNewGame = reply.find("Type 'new'") != std::string::npos;
+                    sendNextCommand(session, options);
+                }
+                if (closed) {
+                    epoll_ctl(epollFd, EPOLL_CTL_DEL, session.fd, nullptr);
+                    close(session.fd);
+                    session.fd = -1;
+                    --open;
+                }
+            }
+        }
+    } catch (...) {
+        for (auto& session : sessions) {
+            if (session.fd >= 0) {
+                close(session.fd);
+            }
+        }
+        close(epollFd);
+        throw;
+    }
+    close(epollFd);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double commands = static_cast<double>(latency.count());
+    os << std::fixed << std::setprecision(2)
+       << "Sessions:         " << options.clients << "\n"
+       << "Commands:         " << latency.count() << "\n"
+       << "Elapsed:          " << seconds << " s\n"
+       << "Commands/sec:     " << (seconds > 0 ? commands / seconds : 0.0) << "\n"
+       << "Latency (us):     p50 " << latency.percentile(0.5) / 1000.0
+       << ", p90 " << latency.percentile(0.9) / 1000.0
+       << ", p99 " << latency.percentile(0.99) / 1000.0
+       << ", max " << latency.max() / 1000.0 << "\n";
+}
@@ -0,0 +1,23 @@
+#ifndef LOAD_CLIENT_H
+#define LOAD_CLIENT_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+struct LoadTestOptions {
+    std::string socketPath;
+    int clients{100};
+    int commands{200};
+    int width{10};
+    int height{10};
+    std::uint64_t seed{1};
+};
+
+// Opens many sessions against a running server and drives them from one
+// epoll loop, each session keeping exactly one command in flight. Every
+// reply's round-trip time goes into a latency histogram, and the summary
+// is written to os once every session has sent its commands.
+void runLoadTest(const LoadTestOptions& options, std::ostream& os);
+
+#endif
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <sys/resource.h>
+#include "gameserver.h"
+#include "loadclient.h"
+
+void displayUsage() {
+    std::cout << "Usage: gameserver --socket PATH [options]\n"
+              << "       gameserver --load-test --socket PATH [options]\n"
+              << "Server options:\n"
+              << "  --width N         - Field width (default 10)\n"
+              << "  --height N        - Field height (default 10)\n"
+              << "  --seed N          - Seed for the session games (default random)\n"
+              << "  --max-sessions N  - Connections served at once (default 10000)\n"
+              << "  --saves DIR       - Directory for save and export files (default .)\n"
+              << "  --event-log FILE  - Append every session's game events to FILE\n"
+              << "Load test options:\n"
+              << "  --clients N       - Concurrent sessions (default 100)\n"
+              << "  --commands N      - Commands sent by each session (default 200)\n"
+              << "  --width N, --height N, --seed N as above\n";
+}
+
+void raiseFileLimit() {
+    rlimit limit{};
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ServerOptions server;
+    LoadTestOptions load;
+    bool loadTest = false;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--load-test") {
+                loadTest = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            std::string value = argv[++i];
+            if (arg == "--socket") {
+                server.socketPath = value;
+                load.socketPath = value;
+            } else if (arg == "--saves") {
+                server.saveDirectory = value;
+            } else if (arg == "--event-log") {
+                server.eventLog = value;
+            } else if (arg == "--seed") {
+                server.seed = std::stoull(value);
+                load.seed = server.seed;
+            } else {
+                long long number = std::stoll(value);
+                if (number <= 0) {
+                    throw std::invalid_argument("Invalid value for " + arg);
+                }
+                if (arg == "--width") {
+                    server.width = load.width = static_cast<int>(number);
+                } else if (arg == "--height") {
+                    server.height = load.height = static_cast<int>(number);
+                } else if (arg == "--max-sessions") {
+                    server.maxSessions = static_cast<std::size_t>(number);
+                } else if (arg == "--clients") {
+                    load.clients = static_cast<int>(number);
+                } else if (arg == "--commands") {
+                    load.commands = static_cast<int>(number);
+                } else {
+                    throw std::invalid_argument("Unknown option " + arg);
+                }
+            }
+        }
+        if (server.socketPath.empty()) {
+            throw std::invalid_argument("--socket is required");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        displayUsage();
+        return 1;
+    }
+
+    raiseFileLimit();
+    try {
+        if (loadTest) {
+            runLoadTest(load, std::cout);
+            return 0;
+        }
+        GameServer gameServer(server);
+        std::cout << "Listening on " << server.socketPath << " (seed " << server.seed << ")" << std::endl;
+        gameServer.run();
+        std::cout << "Shutting down with " << gameServer.getSessionCount() << " open sessions." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Fatal error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "selfplay.h"
+#include <algorithm>
+#include <stdexcept>
+
+void SelfPlayStats::record(const SelfPlayResult& result) {
+    minMoves = games == 0 ? result.moves : std::min(minMoves, result.moves);
+    maxMoves = std::max(maxMoves, result.moves);
+    ++games;
+    moves += result.moves;
+    switch (result.outcome) {
+        case SelfPlayOutcome::StarterWon: ++starterWins; break;
+        case SelfPlayOutcome::ResponderWon: ++responderWins; break;
+        case SelfPlayOutcome::Draw: ++draws; break;
+    }
+}
+
+void SelfPlayStats::merge(const SelfPlayStats& other) {
+    if (other.games == 0) {
+        return;
+    }
+    minMoves = games == 0 ? other.minMoves : std::min(minMoves, other.minMoves);
+    maxMoves = std::max(maxMoves, other.maxMoves);
+    games += other.games;
+    moves += other.moves;
+    starterWins += other.starterWins;
+    responderWins += other.responderWins;
+    draws += other.draws;
+}
+
+SelfPlayMatch::SelfPlayMatch(int width, int height, const std::vector<int>& shipSizes,
+                             TargetingMode mode, const TargetingSettings& settings,
+                             int maxMoves)
+    : width(width), height(height), shipSizes(shipSizes), mode(mode), settings(settings),
+      maxMoves(maxMoves),
+      placer(width, height),
+      firstField(width, height),
+      secondField(width, height),
+      firstShips(shipSizes),
+      secondShips(shipSizes),
+      attacksFirst(&firstField, &firstShips, mode, settings, GameRng()),
+      attacksSecond(&secondField, &secondShips, mode, settings, GameRng()) {
+    firstField.setEventSink(nullEventSink());
+    secondField.setEventSink(nullEventSink());
+}
+
+void SelfPlayMatch::setEventSink(EventSink& sink) {
+    firstField.setEventSink(sink);
+    secondField.setEventSink(sink);
+}
+
+SelfPlayResult SelfPlayMatch::play(GameRng& gen) {
+    firstShips.reset(shipSizes);
+    secondShips.reset(shipSizes);
+    if (!placer.placeFleet(firstField, firstShips, gen) ||
+        !placer.placeFleet(secondField, secondShips, gen)) {
+        throw std::runtime_error("Fleet does not fit on the self-play board");
+    }
+
+    bool firstStarts = gen.coin();
+    ComputerPlayer& starter = firstStarts ? attacksSecond : attacksFirst;
+    ComputerPlayer& responder = firstStarts ? attacksFirst : attacksSecond;
+    starter.reset(gen.split());
+    responder.reset(gen.split());
+    const ShipManager& starterTarget = firstStarts ? secondShips : firstShips;
+    const ShipManager& responderTarget = firstStarts ? firstShips : secondShips;
+
+    int moves = 0;
+    while (moves < maxMoves) {
+        starter.makeMove();
+        ++moves;
+        if (starterTarget.allShipsDestroyed()) {
+            return {SelfPlayOutcome::StarterWon, moves};
+        }
+        responder.makeMove();
+        ++moves;
+        if (responderTarget.allShipsDestroyed()) {
+            return {SelfPlayOutcome::ResponderWon, moves};
+        }
+    }
+    return {SelfPlayOutcome::Draw, moves};
+}
@@ -0,0 +1,63 @@
+#ifndef SELF_PLAY_H
+#define SELF_PLAY_H
+
+#include <vector>
+#include "../mainElements/fleetplacer.h"
+#include "../mainElements/computerplayer.h"
+
+enum class SelfPlayOutcome {
+    StarterWon,
+    ResponderWon,
+    Draw
+};
+
+struct SelfPlayResult {
+    SelfPlayOutcome outcome;
+    int moves;
+};
+
+struct SelfPlayStats {
+    long long games{0};
+    long long moves{0};
+    long long starterWins{0};
+    long long responderWins{0};
+    long long draws{0};
+    int minMoves{0};
+    int maxMoves{0};
+
+    void record(const SelfPlayResult& result);
+    void merge(const SelfPlayStats& other);
+};
+
+// Plays ComputerPlayer against ComputerPlayer on two randomly placed fleets
+// without touching stdin or stdout. The starting side is drawn per game.
+// Fields, fleets and players belong to the match and are reset in place
+// for every game. Events are discarded unless setEventSink names a sink.
+class SelfPlayMatch {
+public:
+    SelfPlayMatch(int width, int height, const std::vector<int>& shipSizes,
+                  TargetingMode mode = TargetingMode::Random,
+                  const TargetingSettings& settings = TargetingSettings(),
+                  int maxMoves = 100000);
+    SelfPlayMatch(const SelfPlayMatch&) = delete;
+    SelfPlayMatch& operator=(const SelfPlayMatch&) = delete;
+    SelfPlayResult play(GameRng& gen);
+    void setEventSink(EventSink& sink);
+
+private:
+    int width;
+    int height;
+    std::vector<int> shipSizes;
+    TargetingMode mode;
+    TargetingSettings settings;
+    int maxMoves;
+    FleetPlacer placer;
+    GameField firstField;
+    GameField secondField;
+    ShipManager firstShips;
+    ShipManager secondShips;
+    ComputerPlayer attacksFirst;
+    ComputerPlayer attacksSecond;
+};
+
+#endif
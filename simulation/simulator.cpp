@@ -0,0 +1,221 @@
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "selfplay.h"
+#include "workstealingpool.h"
+#include "../mainElements/game.h"
+
+// Each pool worker plays on its own slot, so a slot's event sink has a
+// single producer.
+struct alignas(64) WorkerSlot {
+    SelfPlayStats stats;
+    std::ofstream eventFile;
+    std::unique_ptr<AsyncEventSink> events;
+    std::unique_ptr<SelfPlayMatch> match;
+};
+
+struct SimulatorOptions {
+    long long games{100000};
+    unsigned threads{0};
+    int width{10};
+    int height{10};
+    long long fleets{1};
+    long long batch{256};
+    TargetingMode mode{TargetingMode::HuntTarget};
+    long long budgetMs{5};
+    unsigned aiThreads{1};
+    std::uint64_t seed{GameRng::randomSeed()};
+    std::string eventPrefix;
+};
+
+std::string strategyLabel(TargetingMode mode) {
+    switch (mode) {
+        case TargetingMode::Random: return "random";
+        case TargetingMode::HuntTarget: return "hunt";
+        case TargetingMode::MonteCarlo: return "montecarlo";
+    }
+    return "";
+}
+
+void displayUsage() {
+    std::cout << "Usage: simulator [options]\n"
+              << "  --games N       - Number of games to play (default 100000)\n"
+              << "  --threads N     - Worker threads, 0 for all cores (default 0)\n"
+              << "  --width N       - Field width (default 10)\n"
+              << "  --height N      - Field height (default 10)\n"
+              << "  --fleets N      - Copies of the standard fleet per side (default 1)\n"
+              << "  --batch N       - Games per work item (default 256)\n"
+              << "  --ai NAME       - Computer strategy: random, hunt or montecarlo (default hunt)\n"
+              << "  --budget MS     - Monte Carlo time budget per move (default 5)\n"
+              << "  --ai-threads N  - Monte Carlo sampling threads per move (default 1)\n"
+              << "  --seed N        - Seed for fleets and strategies (default random)\n"
+              << "  --events PREFIX - Write each worker's game events to PREFIX.N\n";
+}
+
+SimulatorOptions parseOptions(int argc, char* argv[]) {
+    SimulatorOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+        if (arg == "--ai") {
+            std::string name = argv[++i];
+            if (name == "random") {
+                options.mode = TargetingMode::Random;
+            } else if (name == "hunt") {
+                options.mode = TargetingMode::HuntTarget;
+            } else if (name == "montecarlo") {
+                options.mode = TargetingMode::MonteCarlo;
+            } else {
+                throw std::invalid_argument("Unknown strategy " + name);
+            }
+            continue;
+        }
+        if (arg == "--seed") {
+            options.seed = std::stoull(argv[++i]);
+            continue;
+        }
+        if (arg == "--events") {
+            options.eventPrefix = argv[++i];
+            continue;
+        }
+        long long value = std::stoll(argv[++i]);
+        if (value < 0 || (value == 0 && arg != "--threads")) {
+            throw std::invalid_argument("Invalid value for " + arg);
+        }
+        if (arg == "--games") {
+            options.games = value;
+        } else if (arg == "--threads") {
+            options.threads = static_cast<unsigned>(value);
+        } else if (arg == "--width") {
+            options.width = static_cast<int>(value);
+        } else if (arg == "--height") {
+            options.height = static_cast<int>(value);
+        } else if (arg == "--fleets") {
+            options.fleets = value;
+        } else if (arg == "--batch") {
+            options.batch = value;
+        } else if (arg == "--budget") {
+            options.budgetMs = value;
+        } else if (arg == "--ai-threads") {
+            options.aiThreads = static_cast<unsigned>(value);
+        } else {
+            throw std::invalid_argument("Unknown option " + arg);
+        }
+    }
+    return options;
+}
+
+int main(int argc, char* argv[]) {
+    SimulatorOptions options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        displayUsage();
+        return 1;
+    }
+
+    std::vector<int> fleet;
+    for (long long i = 0; i < options.fleets; ++i) {
+        fleet.insert(fleet.end(), Game::defaultShipSizes().begin(), Game::defaultShipSizes().end());
+    }
+
+    GameRng probe(options.seed);
+    std::vector<ShipPlacement> placements;
+    FleetPlacer placer(options.width, options.height);
+    if (!placer.placeFleet(fleet, probe, placements)) {
+        std::cerr << "Error: the fleet does not fit on a "
+                  << options.width << "x" << options.height << " field\n";
+        return 1;
+    }
+
+    TargetingSettings settings;
+    settings.shipSizes = fleet;
+    settings.moveBudget = std::chrono::milliseconds(options.budgetMs);
+    settings.threads = options.aiThreads;
+
+    WorkStealingPool pool(options.threads);
+    unsigned workers = pool.getThreadCount();
+    std::vector<WorkerSlot> slots(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        WorkerSlot& slot = slots[i];
+        slot.match = std::make_unique<SelfPlayMatch>(
+            options.width, options.height, fleet, options.mode, settings);
+        if (!options.eventPrefix.empty()) {
+            std::string path = options.eventPrefix + "." + std::to_string(i);
+            slot.eventFile.open(path);
+            if (!slot.eventFile) {
+                std::cerr << "Error: cannot open " << path << "\n";
+                return 1;
+            }
+            slot.events = std::make_unique<AsyncEventSink>(slot.eventFile);
+            slot.match->setEventSink(*slot.events);
+        }
+    }
+
+    std::function<void(long long, long long)> runRange;
+    runRange = [&](long long begin, long long end) {
+        while (end - begin > options.batch) {
+            long long middle = begin + (end - begin) / 2;
+            pool.submit([&runRange, middle, end] { runRange(middle, end); });
+            end = middle;
+        }
+        WorkerSlot& slot = slots[WorkStealingPool::currentWorkerIndex()];
+        for (long long game = begin; game < end; ++game) {
+            GameRng gen = GameRng::stream(options.seed, static_cast<std::uint64_t>(game));
+            slot.stats.record(slot.match->play(gen));
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    long long share = options.games / workers;
+    for (unsigned i = 0; i < workers; ++i) {
+        long long begin = share * i;
+        long long end = (i + 1 == workers) ? options.games : begin + share;
+        pool.submit([&runRange, begin, end] { runRange(begin, end); });
+    }
+    pool.wait();
+    for (auto& slot : slots) {
+        if (slot.events) {
+            slot.events->flush();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SelfPlayStats total;
+    for (const auto& slot : slots) {
+        total.merge(slot.stats);
+    }
+
+    double games = static_cast<double>(total.games);
+    std::cout << std::fixed << std::setprecision(2)
+              << "Games played:     " << total.games << "\n"
+              << "Threads:          " << workers << "\n"
+              << "Field:            " << options.width << "x" << options.height << "\n"
+              << "Ships per side:   " << fleet.size() << "\n"
+              << "Strategy:         " << strategyLabel(options.mode);
+    TargetingMode played = ComputerPlayer::supportedMode(options.mode, options.width, options.height);
+    if (played != options.mode) {
+        std::cout << " (field too large, played " << strategyLabel(played) << ")";
+    }
+    std::cout << "\n"
+              << "Seed:             " << options.seed << "\n"
+              << "Elapsed:          " << seconds << " s\n"
+              << "Games/sec:        " << games / seconds << "\n"
+              << "Moves/sec:        " << total.moves / seconds << "\n"
+              << "Moves per game:   avg " << (games > 0 ? total.moves / games : 0.0)
+              << ", min " << total.minMoves << ", max " << total.maxMoves << "\n"
+              << "Starter wins:     " << total.starterWins
+              << " (" << (games > 0 ? 100.0 * total.starterWins / games : 0.0) << "%)\n"
+              << "Responder wins:   " << total.responderWins
+              << " (" << (games > 0 ? 100.0 * total.responderWins / games : 0.0) << "%)\n"
+              << "Draws:            " << total.draws << "\n";
+    return 0;
+}
@@ -0,0 +1,51 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Every worker owns a deque: it pushes and pops its own tasks at the back
+// and, when empty, steals from the front of the other workers' deques.
+// Tasks submitted from inside a worker go to that worker's own deque.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned threadCount = 0);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task);
+    void wait();
+    unsigned getThreadCount() const { return static_cast<unsigned>(threads.size()); }
+    static int currentWorkerIndex();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> pending{0};
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::size_t> nextQueue{0};
+    std::atomic<bool> stopping{false};
+    std::mutex idleMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    void workerLoop(int index);
+    bool popLocal(int index, Task& task);
+    bool steal(int index, Task& task);
+};
+
+#endif